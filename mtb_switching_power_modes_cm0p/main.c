@@ -4,7 +4,8 @@
 *
 * \brief
 * Objective:
-*  This is a CM0+ main() template. It starts the Cortex-M4 and enters deep-sleep.
+*  This is a CM0+ main() template. It starts the Cortex-M4, configures the
+*  power system and the clocks, and enters deep-sleep.
 *
 ********************************************************************************
 * \copyright
@@ -14,8 +15,15 @@
 * the software package with which this file was provided.
 *******************************************************************************/
 #include "cy_pdl.h"
+#if defined(CY_USING_HAL)
 #include "cyhal.h"
+#endif /* defined(CY_USING_HAL) */
 #include "cybsp.h"
+#include "cycfg.h"
+#include "alive_led.h"
+#include "boot_profile.h"
+#include "boot_sync.h"
+#include "stack_watch.h"
 
 
 /*******************************************************************************
@@ -23,7 +31,11 @@
 ********************************************************************************
 *
 * Summary:
-*  Main function of core0. Initializes core1 (CM4) and waits forever.
+*  Main function of core0. Starts core1 (CM4), configures the power system and
+*  the clocks while the CM4 configures its peripherals, and releases the CM4
+*  (see boot_sync.h). It then waits forever. While waiting, it services the
+*  Deep Sleep LED indicator (see alive_led.h) and publishes its stack
+*  high-water mark to the CM4 (see stack_watch.h).
 *
 * Parameters:
 *  None
@@ -34,14 +46,33 @@
 *******************************************************************************/
 int main(void)
 {
+    BootProfile_Mark(BOOT_PROFILE_CM0P_MAIN);
+
+    /* Paint the stack to measure its high-water mark */
+    StackWatch_Init();
+
     /* enable global interrupts */
     __enable_irq();
 
-    /* start up M4 core */
+    /* start up M4 core, it configures its peripherals in parallel */
     Cy_SysEnableCM4(CY_CORTEX_M4_APPL_ADDR);
+    BootProfile_Mark(BOOT_PROFILE_CM0P_CM4_ENABLED);
+
+    /* Configure the power system and the clocks */
+    init_cycfg_system();
+    BootProfile_Mark(BOOT_PROFILE_CM0P_SYSTEM);
+
+    /* Set up the LF timer for the Deep Sleep LED indicator */
+    AliveLed_Init();
+    BootProfile_Mark(BOOT_PROFILE_CM0P_ALIVE_LED);
+
+    /* Let the CM4 use the clocks */
+    BootSync_Post(BOOT_SYNC_CLOCKS_READY);
+    BootProfile_Mark(BOOT_PROFILE_CM0P_CLOCKS_READY);
 
     for (;;)
     {
+        (void)StackWatch_Sample();
         Cy_SysPm_DeepSleep( CY_SYSPM_WAIT_FOR_INTERRUPT );
     }
 }
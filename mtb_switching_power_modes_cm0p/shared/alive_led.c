@@ -0,0 +1,133 @@
+/***************************************************************************//**
+* \file alive_led.c
+* \version 1.0
+*
+* \brief
+* Deep Sleep "alive" indicator on KIT_LED1, timed by the LF clock domain.
+* See alive_led.h for the division of work between the two CPUs.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "alive_led.h"
+
+
+#if (CY_CPU_CORTEX_M0P)
+
+/*******************************************************************************
+* Function Name: AliveLed_Init
+****************************************************************************//**
+*
+* Configures the MCWDT counter and routes its interrupt to the CM0+. The
+* counter is left disabled; the CM4 starts it when it enters Deep Sleep.
+*
+*******************************************************************************/
+void AliveLed_Init(void)
+{
+    const cy_stc_mcwdt_config_t mcwdtConfig =
+    {
+        .c0Match        = ALIVE_LED_PERIOD_TICKS,
+        .c1Match        = 0u,
+        .c0Mode         = CY_MCWDT_MODE_INT,
+        .c1Mode         = CY_MCWDT_MODE_NONE,
+        .c2ToggleBit    = 0u,
+        .c2Mode         = CY_MCWDT_MODE_NONE,
+        .c0ClearOnMatch = true,
+        .c1ClearOnMatch = false,
+        .c0c1Cascade    = false,
+        .c1c2Cascade    = false
+    };
+
+    /* MCWDT interrupt is routed to the CM0+ through an NVIC mux */
+    const cy_stc_sysint_t mcwdtIsr =
+    {
+        .intrSrc      = NvicMux3_IRQn,
+        .cm0pSrc      = srss_interrupt_mcwdt_0_IRQn,
+        .intrPriority = ALIVE_LED_INTR_PRIORITY,
+    };
+
+    (void)Cy_MCWDT_Init(ALIVE_LED_MCWDT_HW, &mcwdtConfig);
+    Cy_MCWDT_SetInterruptMask(ALIVE_LED_MCWDT_HW, ALIVE_LED_MCWDT_MASK);
+
+    (void)Cy_SysInt_Init(&mcwdtIsr, AliveLed_InterruptHandler);
+    NVIC_EnableIRQ(mcwdtIsr.intrSrc);
+}
+
+/*******************************************************************************
+* Function Name: AliveLed_InterruptHandler
+****************************************************************************//**
+*
+* MCWDT match handler. Alternates the LED between a short ON pulse and a long
+* OFF period. The phase is taken from the pin output latch, so the handler
+* keeps no state of its own and the CM4 can restart the sequence at any time.
+*
+*******************************************************************************/
+void AliveLed_InterruptHandler(void)
+{
+    Cy_MCWDT_ClearInterrupt(ALIVE_LED_MCWDT_HW, ALIVE_LED_MCWDT_MASK);
+
+    /* The pin belongs to the TCPWM again once the CM4 is awake */
+    if (HSIOM_SEL_GPIO == Cy_GPIO_GetHSIOM(KIT_LED1_PORT, KIT_LED1_NUM))
+    {
+        if (ALIVE_LED_STATE_ON == Cy_GPIO_ReadOut(KIT_LED1_PORT, KIT_LED1_NUM))
+        {
+            Cy_GPIO_Write(KIT_LED1_PORT, KIT_LED1_NUM, ALIVE_LED_STATE_OFF);
+            Cy_MCWDT_SetMatch(ALIVE_LED_MCWDT_HW, ALIVE_LED_MCWDT_COUNTER, ALIVE_LED_PERIOD_TICKS, 0u);
+        }
+        else
+        {
+            Cy_GPIO_Write(KIT_LED1_PORT, KIT_LED1_NUM, ALIVE_LED_STATE_ON);
+            Cy_MCWDT_SetMatch(ALIVE_LED_MCWDT_HW, ALIVE_LED_MCWDT_COUNTER, ALIVE_LED_PULSE_TICKS, 0u);
+        }
+    }
+}
+
+#else
+
+/*******************************************************************************
+* Function Name: AliveLed_Start
+****************************************************************************//**
+*
+* Hands KIT_LED1 over from the TCPWM to the GPIO output latch (LED OFF) and
+* starts the LF timer. Call right before the CM4 enters Deep Sleep, after the
+* PWM has been disabled.
+*
+*******************************************************************************/
+void AliveLed_Start(void)
+{
+    Cy_GPIO_Write(KIT_LED1_PORT, KIT_LED1_NUM, ALIVE_LED_STATE_OFF);
+    Cy_GPIO_SetHSIOM(KIT_LED1_PORT, KIT_LED1_NUM, HSIOM_SEL_GPIO);
+
+    /* First pulse comes one full period after entering Deep Sleep. Do not
+     * wait for the LF domain to synchronize, Deep Sleep entry follows. */
+    Cy_MCWDT_SetMatch(ALIVE_LED_MCWDT_HW, ALIVE_LED_MCWDT_COUNTER, ALIVE_LED_PERIOD_TICKS, 0u);
+    Cy_MCWDT_Enable(ALIVE_LED_MCWDT_HW, ALIVE_LED_MCWDT_MASK, 0u);
+}
+
+/*******************************************************************************
+* Function Name: AliveLed_Stop
+****************************************************************************//**
+*
+* Stops the LF timer and gives KIT_LED1 back to the TCPWM. Call after waking
+* up from Deep Sleep, before the PWM is re-enabled.
+*
+*******************************************************************************/
+void AliveLed_Stop(void)
+{
+    Cy_MCWDT_Disable(ALIVE_LED_MCWDT_HW, ALIVE_LED_MCWDT_MASK, 0u);
+    Cy_MCWDT_ClearInterrupt(ALIVE_LED_MCWDT_HW, ALIVE_LED_MCWDT_MASK);
+
+    Cy_GPIO_Write(KIT_LED1_PORT, KIT_LED1_NUM, ALIVE_LED_STATE_OFF);
+    Cy_GPIO_SetHSIOM(KIT_LED1_PORT, KIT_LED1_NUM, KIT_LED1_HSIOM);
+}
+
+#endif /* (CY_CPU_CORTEX_M0P) */
+
+/* [] END OF FILE */
@@ -0,0 +1,73 @@
+/***************************************************************************//**
+* \file alive_led.h
+* \version 1.0
+*
+* \brief
+* Deep Sleep "alive" indicator on KIT_LED1, timed by the LF clock domain.
+*
+* The TCPWM that normally drives KIT_LED1 loses its clock in System Deep
+* Sleep. While the CM4 is in Deep Sleep, MCWDT0 counter 0 (clocked from clk_lf)
+* times a short, low duty cycle pulse on the LED pin. The MCWDT interrupt is
+* routed only to the CM0+, which is parked in Deep Sleep anyway: it toggles the
+* pin with a couple of register writes and goes straight back to Deep Sleep.
+* The CM4 is never woken and its SysPm callbacks do not run.
+*
+* This file is shared between the CM0+ and CM4 applications.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ALIVE_LED_H)
+#define ALIVE_LED_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* MCWDT block and counter used to time the indicator */
+#define ALIVE_LED_MCWDT_HW          MCWDT_STRUCT0
+#define ALIVE_LED_MCWDT_COUNTER     CY_MCWDT_COUNTER0
+#define ALIVE_LED_MCWDT_MASK        CY_MCWDT_CTR0
+
+/* Pulse timing (in clk_lf cycles). clk_lf starts on the ILO (32 kHz, +/-30%)
+ * and stays there if the WCO fails, otherwise it moves to the WCO (32.768 kHz):
+ * - period: 2.00 s on the WCO, 2.05 s (1.6 s to 2.9 s) on the ILO
+ * - pulse:  2.01 ms on the WCO, 2.06 ms (1.6 ms to 2.9 ms) on the ILO */
+#define ALIVE_LED_PERIOD_TICKS      65535u  /* ~2 seconds between pulses */
+#define ALIVE_LED_PULSE_TICKS       66u     /* ~2 milliseconds ON time */
+
+/* KIT_LED1 is active low */
+#define ALIVE_LED_STATE_ON          0u
+#define ALIVE_LED_STATE_OFF         1u
+
+/* CM0+ interrupt priority of the MCWDT interrupt */
+#define ALIVE_LED_INTR_PRIORITY     3u
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if (CY_CPU_CORTEX_M0P)
+void AliveLed_Init(void);
+void AliveLed_InterruptHandler(void);
+#else
+void AliveLed_Start(void);
+void AliveLed_Stop(void);
+#endif /* (CY_CPU_CORTEX_M0P) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ALIVE_LED_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,142 @@
+/***************************************************************************//**
+* \file boot_profile.c
+* \version 1.0
+*
+* \brief
+* Startup phase profiler of the CM0+ and CM4. See boot_profile.h.
+*
+* This file is shared between the CM0+ and CM4 applications.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "boot_profile.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#if (CY_CPU_CORTEX_M0P)
+#define BOOT_PROFILE_MAGIC          BOOT_PROFILE_MAGIC_CM0P
+#define BOOT_PROFILE_RESET_STAGE    BOOT_PROFILE_CM0P_RESET
+#define BOOT_PROFILE_LAST_STAGE     BOOT_PROFILE_CM0P_CLOCKS_READY
+
+/* SysTick counts down from its 24-bit reload value */
+#define BOOT_PROFILE_SYSTICK_MAX    0x00FFFFFFu
+#else
+#define BOOT_PROFILE_MAGIC          BOOT_PROFILE_MAGIC_CM4
+#define BOOT_PROFILE_RESET_STAGE    BOOT_PROFILE_CM4_RESET
+#endif /* (CY_CPU_CORTEX_M0P) */
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Written before the C runtime initialization, so none of it is initialized */
+CY_NOINIT BootProfile bootProfile;
+CY_NOINIT static uint32_t bootProfileCycles;    /* Cycles at the last stage */
+CY_NOINIT static uint32_t bootProfileTimeUs;    /* Time at the last stage */
+CY_NOINIT static uint32_t bootProfileCounter;   /* Counter value at the last stage */
+CY_NOINIT static uint32_t bootProfileHz;        /* CPU clock at the last stage */
+
+
+/*******************************************************************************
+* Function Name: BootProfile_Elapsed
+****************************************************************************//**
+*
+* Returns the cycles since the last stage.
+*
+*******************************************************************************/
+static uint32_t BootProfile_Elapsed(void)
+{
+    uint32_t counter;
+    uint32_t elapsed;
+
+#if (CY_CPU_CORTEX_M0P)
+    counter = SysTick->VAL;
+    elapsed = (bootProfileCounter - counter) & BOOT_PROFILE_SYSTICK_MAX;
+#else
+    counter = DWT->CYCCNT;
+    elapsed = counter - bootProfileCounter;
+#endif /* (CY_CPU_CORTEX_M0P) */
+
+    bootProfileCounter = counter;
+
+    return elapsed;
+}
+
+/*******************************************************************************
+* Function Name: Cy_OnResetUser
+****************************************************************************//**
+*
+* Called by the reset handler before the C runtime initialization. Starts the
+* cycle counter and the record. It must not use initialized variables.
+*
+*******************************************************************************/
+void Cy_OnResetUser(void)
+{
+    uint32_t stage;
+
+#if (CY_CPU_CORTEX_M0P)
+    SysTick->LOAD = BOOT_PROFILE_SYSTICK_MAX;
+    SysTick->VAL = 0u;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    bootProfileCounter = SysTick->VAL;
+#else
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    bootProfileCounter = 0u;
+#endif /* (CY_CPU_CORTEX_M0P) */
+
+    bootProfileCycles = 0u;
+    bootProfileTimeUs = 0u;
+    bootProfileHz = BOOT_PROFILE_RESET_HZ;
+
+    bootProfile.magic = BOOT_PROFILE_MAGIC;
+    bootProfile.marked = 1uL << BOOT_PROFILE_RESET_STAGE;
+    for (stage = 0u; stage < BOOT_PROFILE_STAGE_COUNT; stage++)
+    {
+        bootProfile.entries[stage].cycles = 0u;
+        bootProfile.entries[stage].timeUs = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: BootProfile_Mark
+****************************************************************************//**
+*
+* Records the cycle count and the time of the stage. A stage marked again is
+* overwritten. On the CM0+, the last stage stops the SysTick timer.
+*
+*******************************************************************************/
+void BootProfile_Mark(BootProfileStage stage)
+{
+    uint32_t elapsed = BootProfile_Elapsed();
+
+    /* Convert at the clock of the last stage. The 64-bit product does not
+     * overflow and works at clocks that are not whole megahertz. */
+    bootProfileCycles += elapsed;
+    bootProfileTimeUs += (uint32_t)(((uint64_t)elapsed * 1000000u) / bootProfileHz);
+    bootProfileHz = SystemCoreClock;
+
+    bootProfile.entries[stage].cycles = bootProfileCycles;
+    bootProfile.entries[stage].timeUs = bootProfileTimeUs;
+    bootProfile.marked |= 1uL << (uint32_t)stage;
+
+#if (CY_CPU_CORTEX_M0P)
+    /* Profiling is over, the SysTick timer is free again */
+    if (BOOT_PROFILE_LAST_STAGE == stage)
+    {
+        SysTick->CTRL = 0u;
+    }
+#endif /* (CY_CPU_CORTEX_M0P) */
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,120 @@
+/***************************************************************************//**
+* \file boot_profile.h
+* \version 1.0
+*
+* \brief
+* Startup phase profiler of the CM0+ and CM4.
+*
+* Each core records a cycle timestamp at each stage of its boot, from the reset
+* handler to the first check of KIT_BTN1, in a BootProfile record in its
+* .noinit section. The reset handler calls Cy_OnResetUser() before the C
+* runtime initialization, which starts the cycle counter and the record, so
+* the copy of .data (with the SRAM code) and the zeroing of .bss are included.
+*
+* A debugger reads the records as bootProfile in each image. A host tool finds
+* them in a RAM dump by their magic number. The cycles are counted from the
+* reset of the core: the DWT cycle counter on the CM4, the SysTick timer on
+* the CM0+ (extended to 32 bits, stages must be less than 2^24 cycles apart).
+* The CM0+ stops the SysTick timer at BOOT_PROFILE_CM0P_CLOCKS_READY, its last
+* stage.
+* The CM4 leaves reset at BOOT_PROFILE_CM0P_CM4_ENABLED.
+*
+* Each time is converted from cycles at the clock frequency of the previous
+* stage, so the time of a stage during which the CPU clock changes is
+* approximate: init_cycfg_system() on the CM0+, and the wait for the clocks on
+* the CM4. init_cycfg_system() is generated code, so the power system, clock
+* path, FLL and PLL configuration inside it are recorded as one stage.
+*
+* Deep Sleep restarts the cycle counter of the CM4 (see fast_wake.h), so the
+* CM4 stages recorded after one are not valid: BOOT_PROFILE_CM4_WCO if the
+* device sleeps before the WCO is ready, and the stages after the calibration
+* when PM_CALIBRATION=1 calibrates at startup.
+*
+* This file is shared between the CM0+ and CM4 applications.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(BOOT_PROFILE_H)
+#define BOOT_PROFILE_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+typedef enum
+{
+    /* CM0+ stages */
+    BOOT_PROFILE_CM0P_RESET         = 0u,   /* Reset handler */
+    BOOT_PROFILE_CM0P_MAIN          = 1u,   /* main(), after the C runtime initialization */
+    BOOT_PROFILE_CM0P_CM4_ENABLED   = 2u,   /* CM4 out of reset */
+    BOOT_PROFILE_CM0P_SYSTEM        = 3u,   /* Power system and clocks configured, FLL and PLL locked */
+    BOOT_PROFILE_CM0P_ALIVE_LED     = 4u,   /* Deep Sleep LED indicator set up */
+    BOOT_PROFILE_CM0P_CLOCKS_READY  = 5u,   /* BOOT_SYNC_CLOCKS_READY posted */
+
+    /* CM4 stages */
+    BOOT_PROFILE_CM4_RESET          = 6u,   /* Reset handler */
+    BOOT_PROFILE_CM4_MAIN           = 7u,   /* main(), after the C runtime initialization */
+    BOOT_PROFILE_CM4_BOARD          = 8u,   /* Pins, routing and peripherals configured */
+    BOOT_PROFILE_CM4_CLOCKS_READY   = 9u,   /* BOOT_SYNC_CLOCKS_READY passed */
+    BOOT_PROFILE_CM4_CLOCK_MANAGER  = 10u,  /* Unused clock roots stopped */
+    BOOT_PROFILE_CM4_SMIF           = 11u,  /* QSPI memory initialized */
+    BOOT_PROFILE_CM4_TELEMETRY      = 12u,  /* Time base started, WCO enabled, telemetry log recovered */
+    BOOT_PROFILE_CM4_CALLBACKS      = 13u,  /* Wake-up interrupt and SysPm callbacks registered */
+    BOOT_PROFILE_CM4_TCPWM          = 14u,  /* TCPWM initialized, PWM LED enabled */
+    BOOT_PROFILE_CM4_READY          = 15u,  /* First check of KIT_BTN1 */
+    BOOT_PROFILE_CM4_WCO            = 16u,  /* clk_lf on the WCO, usually after BOOT_PROFILE_CM4_READY */
+
+    BOOT_PROFILE_STAGE_COUNT        = 17u,
+} BootProfileStage;
+
+/* Magic numbers of the records */
+#define BOOT_PROFILE_MAGIC_CM0P     0x30504D42u     /* "BMP0" */
+#define BOOT_PROFILE_MAGIC_CM4      0x34504D42u     /* "BMP4" */
+
+/* CPU clock out of reset: the IMO, undivided */
+#define BOOT_PROFILE_RESET_HZ       8000000u
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t cycles;        /* Core cycles since the reset of the core */
+    uint32_t timeUs;        /* Microseconds since the reset of the core */
+} BootProfileEntry;
+
+typedef struct
+{
+    uint32_t magic;         /* BOOT_PROFILE_MAGIC_CM0P or BOOT_PROFILE_MAGIC_CM4 */
+    uint32_t marked;        /* Bit per recorded stage */
+    BootProfileEntry entries[BOOT_PROFILE_STAGE_COUNT];
+} BootProfile;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern BootProfile bootProfile;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void BootProfile_Mark(BootProfileStage stage);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BOOT_PROFILE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,76 @@
+/***************************************************************************//**
+* \file boot_sync.c
+* \version 1.0
+*
+* \brief
+* Boot barriers between the CM0+ and the CM4. See boot_sync.h.
+*
+* This file is shared between the CM0+ and CM4 applications.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "boot_sync.h"
+
+
+/*******************************************************************************
+* Function Name: BootSync_Post
+****************************************************************************//**
+*
+* Posts the barrier. Everything the core wrote before is complete when the
+* other core sees it.
+*
+*******************************************************************************/
+void BootSync_Post(uint32_t barrier)
+{
+    IPC_STRUCT_Type *ipcBase = Cy_IPC_Drv_GetIpcBaseAddress(BOOT_SYNC_IPC_CHANNEL);
+
+    __DSB();
+
+    /* The channel lock serializes the updates of both cores */
+    while (CY_IPC_DRV_SUCCESS != Cy_IPC_Drv_LockAcquire(ipcBase))
+    {
+        /* The other core is posting a barrier */
+    }
+    Cy_IPC_Drv_WriteDataValue(ipcBase, Cy_IPC_Drv_ReadDataValue(ipcBase) | barrier);
+    (void)Cy_IPC_Drv_LockRelease(ipcBase, CY_IPC_NO_NOTIFICATION);
+}
+
+/*******************************************************************************
+* Function Name: BootSync_IsPosted
+****************************************************************************//**
+*
+* Returns true if the barrier has been posted.
+*
+*******************************************************************************/
+bool BootSync_IsPosted(uint32_t barrier)
+{
+    IPC_STRUCT_Type *ipcBase = Cy_IPC_Drv_GetIpcBaseAddress(BOOT_SYNC_IPC_CHANNEL);
+
+    return (barrier == (Cy_IPC_Drv_ReadDataValue(ipcBase) & barrier));
+}
+
+/*******************************************************************************
+* Function Name: BootSync_Wait
+****************************************************************************//**
+*
+* Waits until the barrier has been posted.
+*
+*******************************************************************************/
+void BootSync_Wait(uint32_t barrier)
+{
+    while (!BootSync_IsPosted(barrier))
+    {
+        /* Wait for the other core */
+    }
+
+    __DMB();
+}
+
+/* [] END OF FILE */
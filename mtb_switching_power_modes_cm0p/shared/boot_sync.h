@@ -0,0 +1,62 @@
+/***************************************************************************//**
+* \file boot_sync.h
+* \version 1.0
+*
+* \brief
+* Boot barriers between the CM0+ and the CM4.
+*
+* The two cores configure the device in parallel. The CM0+ starts the CM4
+* first and then configures the power system and the clocks
+* (init_cycfg_system()). Meanwhile, the CM4 configures its pins, routing,
+* peripheral clock dividers and peripherals, which do not depend on the clock
+* frequencies. The CM4 then waits at the BOOT_SYNC_CLOCKS_READY barrier before
+* it uses anything that does.
+*
+* Each barrier is a bit in the DATA register of an IPC channel that is not
+* used otherwise. A core posts a barrier by setting its bit under the channel
+* lock; the other core polls for it. The IPC registers are only reset with
+* the device, so a CM4 reset from the debugger finds the barriers it depends
+* on already posted.
+*
+* This file is shared between the CM0+ and CM4 applications.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(BOOT_SYNC_H)
+#define BOOT_SYNC_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* IPC channel that holds the barriers: the first channel for the application */
+#define BOOT_SYNC_IPC_CHANNEL       CY_IPC_CHAN_USER
+
+/* Barriers */
+#define BOOT_SYNC_CLOCKS_READY      0x01u   /* CM0+: power system and clocks configured */
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void BootSync_Post(uint32_t barrier);
+bool BootSync_IsPosted(uint32_t barrier);
+void BootSync_Wait(uint32_t barrier);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BOOT_SYNC_H */
+
+/* [] END OF FILE */
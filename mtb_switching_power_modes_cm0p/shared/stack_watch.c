@@ -0,0 +1,113 @@
+/***************************************************************************//**
+* \file stack_watch.c
+* \version 1.0
+*
+* \brief
+* Stack high-water marks of the CM0+ and CM4. See stack_watch.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "stack_watch.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Bounds of the stack, from the linker script */
+extern uint32_t __StackLimit[];
+extern uint32_t __StackTop[];
+
+/* Lowest word known to be used */
+static uint32_t *stackWatchLowest = __StackTop;
+
+
+/*******************************************************************************
+* Function Name: StackWatch_Init
+****************************************************************************//**
+*
+* Paints the free part of the stack. Call at the start of main(), with the
+* interrupts disabled.
+*
+*******************************************************************************/
+void StackWatch_Init(void)
+{
+    uint32_t *word;
+
+    stackWatchLowest = (uint32_t *)__get_MSP();
+
+    for (word = __StackLimit; word < stackWatchLowest; word++)
+    {
+        *word = STACK_WATCH_PATTERN;
+    }
+}
+
+/*******************************************************************************
+* Function Name: StackWatch_Sample
+****************************************************************************//**
+*
+* Updates and returns the high-water mark of the stack, in bytes. The CM0+
+* also publishes it to the CM4.
+*
+*******************************************************************************/
+uint32_t StackWatch_Sample(void)
+{
+    uint32_t *word = stackWatchLowest;
+    uint32_t gap = 0u;
+    uint32_t highWater;
+
+    while ((word > __StackLimit) && (gap < STACK_WATCH_GAP_WORDS))
+    {
+        word--;
+        if (STACK_WATCH_PATTERN == *word)
+        {
+            gap++;
+        }
+        else
+        {
+            gap = 0u;
+            stackWatchLowest = word;
+        }
+    }
+
+    highWater = (uint32_t)__StackTop - (uint32_t)stackWatchLowest;
+
+#if (CY_CPU_CORTEX_M0P)
+    Cy_IPC_Drv_WriteDataValue(Cy_IPC_Drv_GetIpcBaseAddress(STACK_WATCH_IPC_CHANNEL), highWater);
+#endif /* (CY_CPU_CORTEX_M0P) */
+
+    return highWater;
+}
+
+/*******************************************************************************
+* Function Name: StackWatch_GetSize
+****************************************************************************//**
+*
+* Returns the size of the stack reserved by the linker script, in bytes.
+*
+*******************************************************************************/
+uint32_t StackWatch_GetSize(void)
+{
+    return (uint32_t)__StackTop - (uint32_t)__StackLimit;
+}
+
+/*******************************************************************************
+* Function Name: StackWatch_GetPublished
+****************************************************************************//**
+*
+* Returns the last high-water mark published by the CM0+, in bytes (0 before
+* its first sample).
+*
+*******************************************************************************/
+uint32_t StackWatch_GetPublished(void)
+{
+    return Cy_IPC_Drv_ReadDataValue(Cy_IPC_Drv_GetIpcBaseAddress(STACK_WATCH_IPC_CHANNEL));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,69 @@
+/***************************************************************************//**
+* \file stack_watch.h
+* \version 1.0
+*
+* \brief
+* Stack high-water marks of the CM0+ and CM4.
+*
+* StackWatch_Init(), called at the start of main(), paints the free part of
+* the stack (from __StackLimit up to the stack pointer) with
+* STACK_WATCH_PATTERN.
+* StackWatch_Sample(), called from the idle path, scans down from the lowest
+* word known to be used until it finds STACK_WATCH_GAP_WORDS painted words in
+* a row, so a sample only costs the growth since the previous one. A deeper
+* frame that leaves more words than that unwritten (a large local array, for
+* example) can hide the words below it, so the mark is a lower bound.
+*
+* The high-water mark is the distance from __StackTop to the lowest used word.
+* It reaches the stack size when the stack has overflowed, or nearly so.
+*
+* The CM0+ publishes its mark in the DATA register of an IPC channel that is
+* not used otherwise. Only the CM0+ writes it, so no lock is needed. The CM4
+* reads it with StackWatch_GetPublished() and logs both marks (see
+* telemetry_log.h).
+*
+* This file is shared between the CM0+ and CM4 applications.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(STACK_WATCH_H)
+#define STACK_WATCH_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define STACK_WATCH_PATTERN         0xA5A5A5A5u
+
+/* Painted words in a row that end a scan */
+#define STACK_WATCH_GAP_WORDS       16u
+
+/* IPC channel that holds the mark of the CM0+, next to the boot barriers */
+#define STACK_WATCH_IPC_CHANNEL     (CY_IPC_CHAN_USER + 1u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void StackWatch_Init(void);
+uint32_t StackWatch_Sample(void);
+uint32_t StackWatch_GetSize(void);
+uint32_t StackWatch_GetPublished(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* STACK_WATCH_H */
+
+/* [] END OF FILE */
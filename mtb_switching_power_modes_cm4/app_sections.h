@@ -0,0 +1,62 @@
+/***************************************************************************//**
+* \file app_sections.h
+* \version 1.0
+*
+* \brief
+* Code placement attributes of the CM4 application.
+*
+* APP_COLD marks code that runs rarely (initialization, recovery,
+* diagnostics). When the application is built with XIP_COLD_CODE=1, that code
+* is linked into the .cy_xip section of the BSP linker script and executes in
+* place from the QSPI memory at 0x18000000, freeing internal flash. Otherwise
+* the attribute has no effect.
+*
+* Cold code can only run while the QSPI memory is memory-mapped: after
+* SmifMem_Init(), while the caller holds RuntimePm_Get(RUNTIME_PM_DEV_SMIF),
+* and never while SmifMem_IsBusy(), in System ULP or inside the Deep Sleep
+* callbacks. Interrupt handlers and SysPm callbacks must never be cold.
+*
+* APP_HOT marks the short routines on the power mode transition and wake-up
+* paths. When the application is built with RAMFUNC_HOT_CODE=1 (the default),
+* that code is linked into the .cy_ramfunc section, which the BSP linker
+* script places in .data, so the startup code copies it to SRAM together with
+* the initialized variables. It then runs without flash wait states, which
+* matter most in System ULP. Library functions it calls still run from flash.
+*
+* APP_SECTION_XIP and APP_SECTION_RAMFUNC always apply their placement. They
+* are meant for benchmarks only.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(APP_SECTIONS_H)
+#define APP_SECTIONS_H
+
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define APP_SECTION_XIP         CY_SECTION(".cy_xip") CY_NOINLINE
+#define APP_SECTION_RAMFUNC     CY_SECTION(".cy_ramfunc") CY_NOINLINE
+
+#if defined(APP_XIP_COLD_CODE)
+#define APP_COLD    APP_SECTION_XIP
+#else
+#define APP_COLD
+#endif /* defined(APP_XIP_COLD_CODE) */
+
+#if defined(APP_RAMFUNC_HOT_CODE)
+#define APP_HOT     APP_SECTION_RAMFUNC
+#else
+#define APP_HOT
+#endif /* defined(APP_RAMFUNC_HOT_CODE) */
+
+#endif /* APP_SECTIONS_H */
+
+/* [] END OF FILE */
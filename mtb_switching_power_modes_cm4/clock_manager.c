@@ -0,0 +1,393 @@
+/***************************************************************************//**
+* \file clock_manager.c
+* \version 1.0
+*
+* \brief
+* Power-mode-aware management of the CLK_HF roots. See clock_manager.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "app_sections.h"
+#include "smif_mem.h"
+#include "clock_manager.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Peripheral running from a CLK_HF root */
+typedef struct
+{
+    uint32_t clkHf;             /* CLK_HF root */
+    uint32_t modes;             /* CLOCK_MANAGER_MODE_MASK() of the modes it runs in */
+    bool (*stop)(void);         /* Stops it and releases its clocks, or NULL */
+    void (*start)(void);        /* Acquires its clocks and restarts it, or NULL */
+} ClockManagerUser;
+
+static const ClockManagerUser clockUsers[] =
+{
+    /* CPUs, clk_peri and the peripheral clock dividers */
+    { 0u, CLOCK_MANAGER_MODE_MASK_ALL, NULL, NULL },
+
+    /* SMIF: telemetry log and XIP code. The log is only written in System
+     * LP, and cold code only runs at startup. */
+    { 2u, CLOCK_MANAGER_MODE_MASK(CLOCK_MANAGER_MODE_LP), SmifMem_Suspend, SmifMem_Resume },
+};
+
+#define CLOCK_MANAGER_USERS     (sizeof(clockUsers) / sizeof(clockUsers[0]))
+
+/* Kinds of reference-counted clocks */
+typedef enum
+{
+    CLOCK_MANAGER_KIND_HF       = 0u,   /* CLK_HF root */
+    CLOCK_MANAGER_KIND_DIVIDER  = 1u,   /* Peripheral clock divider */
+} ClockManagerKind;
+
+/* Reference-counted clock */
+typedef struct
+{
+    ClockManagerKind kind;
+    cy_en_divider_types_t dividerType;  /* Divider type (dividers only) */
+    uint32_t num;                       /* CLK_HF root or divider number */
+} ClockManagerGate;
+
+static const ClockManagerGate clockGates[CLOCK_MANAGER_CLK_COUNT] =
+{
+    [CLOCK_MANAGER_CLK_HF2]       = { CLOCK_MANAGER_KIND_HF, CY_SYSCLK_DIV_8_BIT, 2u },
+    [CLOCK_MANAGER_CLK_CSD_DIV]   = { CLOCK_MANAGER_KIND_DIVIDER, CYBSP_CSD_CLK_DIV_HW, CYBSP_CSD_CLK_DIV_NUM },
+    [CLOCK_MANAGER_CLK_TCPWM_DIV] = { CLOCK_MANAGER_KIND_DIVIDER, peri_0_div_8_1_HW, peri_0_div_8_1_NUM },
+};
+
+/* SysPm callbacks: the clock roots are stopped last on entry to System ULP
+ * and restarted first on exit */
+static const SysPmRegistryEntry clockManagerSysPmEntries[] =
+{
+    { ClockManager_EnterUltraLowPowerCallback, CY_SYSPM_ULP,
+      SYSPM_PHASE_CHECK_READY | SYSPM_PHASE_BEFORE_TRANSITION, SYSPM_PRIORITY_CLOCK_ROOT },
+    { ClockManager_ExitUltraLowPowerCallback, CY_SYSPM_LP,
+      SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_CLOCK_ROOT },
+};
+
+const SysPmRegistryTable clockManagerSysPmTable =
+{
+    clockManagerSysPmEntries, sizeof(clockManagerSysPmEntries) / sizeof(clockManagerSysPmEntries[0])
+};
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Users stopped on entry to System ULP (bit per clockUsers entry) */
+static uint32_t clockUlpStopped = 0u;
+
+/* Reference counts of clockGates */
+static uint8_t clockRefCount[CLOCK_MANAGER_CLK_COUNT];
+
+
+/*******************************************************************************
+* Function Name: ClockManager_Gate
+****************************************************************************//**
+*
+* Starts or stops a reference-counted clock.
+*
+*******************************************************************************/
+static APP_HOT void ClockManager_Gate(ClockManagerClock clock, bool run)
+{
+    const ClockManagerGate *gate = &clockGates[clock];
+
+    if (CLOCK_MANAGER_KIND_HF == gate->kind)
+    {
+        if (run)
+        {
+            (void)Cy_SysClk_ClkHfEnable(gate->num);
+        }
+        else
+        {
+            (void)Cy_SysClk_ClkHfDisable(gate->num);
+        }
+    }
+    else
+    {
+        if (run)
+        {
+            (void)Cy_SysClk_PeriphEnableDivider(gate->dividerType, gate->num);
+        }
+        else
+        {
+            (void)Cy_SysClk_PeriphDisableDivider(gate->dividerType, gate->num);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: ClockManager_Acquire
+****************************************************************************//**
+*
+* Takes a reference on clock, starting it if it was stopped. Can be called
+* from interrupt handlers.
+*
+*******************************************************************************/
+APP_HOT void ClockManager_Acquire(ClockManagerClock clock)
+{
+    uint32_t interruptState;
+
+    CY_ASSERT(clock < CLOCK_MANAGER_CLK_COUNT);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    CY_ASSERT(clockRefCount[clock] < UINT8_MAX);
+    if (0u == clockRefCount[clock]++)
+    {
+        ClockManager_Gate(clock, true);
+    }
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: ClockManager_Release
+****************************************************************************//**
+*
+* Drops a reference on clock. The last release stops the clock. Can be called
+* from interrupt handlers.
+*
+*******************************************************************************/
+APP_HOT void ClockManager_Release(ClockManagerClock clock)
+{
+    uint32_t interruptState;
+
+    CY_ASSERT(clock < CLOCK_MANAGER_CLK_COUNT);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    CY_ASSERT(0u != clockRefCount[clock]);
+    if (1u == clockRefCount[clock]--)
+    {
+        ClockManager_Gate(clock, false);
+    }
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: ClockManager_SetDivider
+****************************************************************************//**
+*
+* Sets the integer value of a reference-counted peripheral clock divider (the
+* clock is divided by value + 1). A running divider is restarted with the new
+* value; a stopped one keeps it until it is acquired.
+*
+*******************************************************************************/
+APP_HOT void ClockManager_SetDivider(ClockManagerClock clock, uint32_t value)
+{
+    const ClockManagerGate *gate = &clockGates[clock];
+    uint32_t interruptState;
+
+    CY_ASSERT(CLOCK_MANAGER_KIND_DIVIDER == gate->kind);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    if (0u != clockRefCount[clock])
+    {
+        ClockManager_Gate(clock, false);
+    }
+    (void)Cy_SysClk_PeriphSetDivider(gate->dividerType, gate->num, value);
+    if (0u != clockRefCount[clock])
+    {
+        ClockManager_Gate(clock, true);
+    }
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: ClockManager_GetRefCount
+****************************************************************************//**
+*
+* Returns the number of references held on clock.
+*
+*******************************************************************************/
+uint32_t ClockManager_GetRefCount(ClockManagerClock clock)
+{
+    return clockRefCount[clock];
+}
+
+
+/*******************************************************************************
+* Function Name: ClockManager_GetRequiredHf
+****************************************************************************//**
+*
+* Returns the mask of the CLK_HF roots that the application needs in mode.
+*
+*******************************************************************************/
+uint32_t ClockManager_GetRequiredHf(ClockManagerMode mode)
+{
+    uint32_t required = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < CLOCK_MANAGER_USERS; i++)
+    {
+        if (0u != (clockUsers[i].modes & CLOCK_MANAGER_MODE_MASK(mode)))
+        {
+            required |= 1UL << clockUsers[i].clkHf;
+        }
+    }
+
+    return required;
+}
+
+/*******************************************************************************
+* Function Name: ClockManager_Init
+****************************************************************************//**
+*
+* Stops the CLK_HF roots that no power mode needs (in this design CLK_HF3 and
+* CLK_HF4), then the PLLs that do not feed a running root (PLL1 on path 2),
+* and finally the reference-counted clocks, until a driver acquires them.
+* Must be called once the CM0+ has configured the clocks. It runs before
+* SmifMem_Init(), so it cannot be cold code.
+*
+*******************************************************************************/
+void ClockManager_Init(void)
+{
+    uint32_t used = 0u;
+    uint32_t fed = 0u;
+    uint32_t mode;
+    uint32_t hf;
+    uint32_t path;
+    uint32_t clock;
+
+    for (mode = 0u; mode < (uint32_t)CLOCK_MANAGER_MODE_COUNT; mode++)
+    {
+        used |= ClockManager_GetRequiredHf((ClockManagerMode)mode);
+    }
+
+    /* CLK_HF0 cannot be stopped */
+    for (hf = 1u; hf < CY_SRSS_NUM_HFROOT; hf++)
+    {
+        if (0u == (used & (1UL << hf)))
+        {
+            (void)Cy_SysClk_ClkHfDisable(hf);
+        }
+        else
+        {
+            fed |= 1UL << (uint32_t)Cy_SysClk_ClkHfGetSource(hf);
+        }
+    }
+    fed |= 1UL << (uint32_t)Cy_SysClk_ClkHfGetSource(0u);
+
+    /* PLLs are on paths 1 to CY_SRSS_NUM_PLL */
+    for (path = 1u; path <= CY_SRSS_NUM_PLL; path++)
+    {
+        if ((0u == (fed & (1UL << path))) && Cy_SysClk_PllIsEnabled(path))
+        {
+            (void)Cy_SysClk_PllDisable(path);
+        }
+    }
+
+    /* Reference-counted clocks run only while a driver holds them */
+    for (clock = 0u; clock < (uint32_t)CLOCK_MANAGER_CLK_COUNT; clock++)
+    {
+        ClockManager_Gate((ClockManagerClock)clock, false);
+    }
+}
+
+/*******************************************************************************
+* Function Name: ClockManager_EnterUltraLowPowerCallback
+****************************************************************************//**
+*
+* Enter System ULP callback implementation. Refuses the transition while a
+* peripheral that does not run in ULP cannot be stopped: the QSPI memory is
+* erasing a sector (see telemetry_log.h). A page program is waited for. Before
+* the transition, it stops those peripherals, which release their clocks.
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t ClockManager_EnterUltraLowPowerCallback(
+        cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+    uint32_t i;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            /* A page program takes up to 1.3 ms and is waited for, an erase up
+             * to 2.6 s, as in the SMIF Deep Sleep callback */
+            retVal = SmifMem_FinishProgram() ? CY_SYSPM_SUCCESS : CY_SYSPM_FAIL;
+            break;
+
+        case CY_SYSPM_BEFORE_TRANSITION:
+            retVal = CY_SYSPM_SUCCESS;
+            for (i = 0u; i < CLOCK_MANAGER_USERS; i++)
+            {
+                if ((0u == (clockUsers[i].modes & CLOCK_MANAGER_MODE_MASK(CLOCK_MANAGER_MODE_ULP))) &&
+                    (NULL != clockUsers[i].stop))
+                {
+                    if (clockUsers[i].stop())
+                    {
+                        clockUlpStopped |= 1UL << i;
+                    }
+                    else
+                    {
+                        /* The peripheral keeps its clock */
+                        retVal = CY_SYSPM_FAIL;
+                    }
+                }
+            }
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+/*******************************************************************************
+* Function Name: ClockManager_ExitUltraLowPowerCallback
+****************************************************************************//**
+*
+* Exit System ULP callback implementation. After the transition, it restarts
+* the peripherals stopped on entry to ULP.
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t ClockManager_ExitUltraLowPowerCallback(
+        cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+    uint32_t i;
+
+    switch (mode)
+    {
+        case CY_SYSPM_AFTER_TRANSITION:
+            for (i = 0u; i < CLOCK_MANAGER_USERS; i++)
+            {
+                if ((0u != (clockUlpStopped & (1UL << i))) && (NULL != clockUsers[i].start))
+                {
+                    clockUsers[i].start();
+                }
+            }
+            clockUlpStopped = 0u;
+
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/***************************************************************************//**
+* \file clock_manager.h
+* \version 1.0
+*
+* \brief
+* Power-mode-aware management of the CLK_HF roots.
+*
+* The design configures more clock roots than the application uses. A const
+* table lists which peripherals the application runs from which CLK_HF root,
+* and in which System power modes. At startup, the roots that no entry uses
+* are stopped, together with the PLLs that no longer feed a running root. On
+* entry to System ULP, the peripherals only needed in System LP are stopped,
+* and they are restarted on exit.
+*
+* Clocks that are shared or switched at run time (CLK_HF2 and the peripheral
+* clock dividers) are reference-counted. Drivers acquire them while they use
+* them, and the last release stops the clock. Acquire and release are short
+* critical sections and can be called from interrupt handlers.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CLOCK_MANAGER_H)
+#define CLOCK_MANAGER_H
+
+#include "cy_pdl.h"
+#include "syspm_registry.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* System power modes of the CPU-active states */
+typedef enum
+{
+    CLOCK_MANAGER_MODE_LP   = 0u,
+    CLOCK_MANAGER_MODE_ULP  = 1u,
+    CLOCK_MANAGER_MODE_COUNT = 2u,
+} ClockManagerMode;
+
+#define CLOCK_MANAGER_MODE_MASK(mode)   (1UL << (uint32_t)(mode))
+#define CLOCK_MANAGER_MODE_MASK_ALL     ((1UL << (uint32_t)CLOCK_MANAGER_MODE_COUNT) - 1UL)
+
+/* Reference-counted clocks */
+typedef enum
+{
+    CLOCK_MANAGER_CLK_HF2       = 0u,   /* SMIF */
+    CLOCK_MANAGER_CLK_CSD_DIV   = 1u,   /* CSD (8-bit divider 0), unused */
+    CLOCK_MANAGER_CLK_TCPWM_DIV = 2u,   /* APP_COUNTER and KIT_LED1_PWM (8-bit divider 1) */
+    CLOCK_MANAGER_CLK_COUNT     = 3u,
+} ClockManagerClock;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const SysPmRegistryTable clockManagerSysPmTable;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ClockManager_Init(void);
+uint32_t ClockManager_GetRequiredHf(ClockManagerMode mode);
+
+void ClockManager_Acquire(ClockManagerClock clock);
+void ClockManager_Release(ClockManagerClock clock);
+uint32_t ClockManager_GetRefCount(ClockManagerClock clock);
+void ClockManager_SetDivider(ClockManagerClock clock, uint32_t value);
+
+cy_en_syspm_status_t ClockManager_EnterUltraLowPowerCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+cy_en_syspm_status_t ClockManager_ExitUltraLowPowerCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CLOCK_MANAGER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,57 @@
+/***************************************************************************//**
+* \file cycle_counter.h
+* \version 1.0
+*
+* \brief
+* CPU cycle counter (DWT CYCCNT) of the CM4, used to benchmark code paths.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CYCLE_COUNTER_H)
+#define CYCLE_COUNTER_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Function Name: CycleCounter_Init
+****************************************************************************//**
+*
+* Enables the trace block and starts the cycle counter.
+*
+*******************************************************************************/
+__STATIC_INLINE void CycleCounter_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*******************************************************************************
+* Function Name: CycleCounter_Get
+****************************************************************************//**
+*
+* Returns the current cycle count. Differences are valid across one wrap.
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t CycleCounter_Get(void)
+{
+    return DWT->CYCCNT;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CYCLE_COUNTER_H */
+
+/* [] END OF FILE */
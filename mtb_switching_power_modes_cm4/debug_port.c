@@ -0,0 +1,123 @@
+/***************************************************************************//**
+* \file debug_port.c
+* \version 1.0
+*
+* \brief
+* Production mode: release of the debug port. See debug_port.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "debug_port.h"
+
+
+#if defined(PRODUCTION_MODE)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static bool debugPortReleased = false;
+
+
+/*******************************************************************************
+* Function Name: DebugPort_Init
+****************************************************************************//**
+*
+* Releases the debug port, unless a debugger is attached or KIT_BTN1 is held
+* down. Call after init_cycfg_pins().
+*
+*******************************************************************************/
+void DebugPort_Init(void)
+{
+    /* KIT_BTN1 is active low, with a pull-up */
+    if (!DebugPort_IsDebuggerAttached() && (0u != Cy_GPIO_Read(KIT_BTN1_PORT, KIT_BTN1_NUM)))
+    {
+        DebugPort_Release();
+    }
+}
+
+/*******************************************************************************
+* Function Name: DebugPort_Release
+****************************************************************************//**
+*
+* Disables the access ports and sets the SWD and SWO pins to analog high-Z.
+* Does nothing if a debugger is attached.
+*
+*******************************************************************************/
+void DebugPort_Release(void)
+{
+    uint32_t interruptState;
+
+    if (!DebugPort_IsDebuggerAttached())
+    {
+        interruptState = Cy_SysLib_EnterCriticalSection();
+
+        CPUSS->AP_CTL &= ~DEBUG_PORT_AP_MASK;
+
+        Cy_GPIO_Pin_FastInit(CYBSP_SWDIO_PORT, CYBSP_SWDIO_PIN, CY_GPIO_DM_ANALOG, 0u, HSIOM_SEL_GPIO);
+        Cy_GPIO_Pin_FastInit(CYBSP_SWDCK_PORT, CYBSP_SWDCK_PIN, CY_GPIO_DM_ANALOG, 0u, HSIOM_SEL_GPIO);
+        Cy_GPIO_Pin_FastInit(CYBSP_SWO_PORT, CYBSP_SWO_PIN, CY_GPIO_DM_ANALOG, 0u, HSIOM_SEL_GPIO);
+        debugPortReleased = true;
+
+        Cy_SysLib_ExitCriticalSection(interruptState);
+    }
+}
+
+/*******************************************************************************
+* Function Name: DebugPort_Enable
+****************************************************************************//**
+*
+* Gives the SWD and SWO pins back to the CPUSS, with their configuration from
+* the device configurator, and enables the access ports.
+*
+*******************************************************************************/
+void DebugPort_Enable(void)
+{
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    (void)Cy_GPIO_Pin_Init(CYBSP_SWO_PORT, CYBSP_SWO_PIN, &CYBSP_SWO_config);
+    (void)Cy_GPIO_Pin_Init(CYBSP_SWDIO_PORT, CYBSP_SWDIO_PIN, &CYBSP_SWDIO_config);
+    (void)Cy_GPIO_Pin_Init(CYBSP_SWDCK_PORT, CYBSP_SWDCK_PIN, &CYBSP_SWDCK_config);
+
+    CPUSS->AP_CTL |= DEBUG_PORT_AP_MASK;
+    debugPortReleased = false;
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: DebugPort_IsDebuggerAttached
+****************************************************************************//**
+*
+* Returns true if a debugger has enabled halting debug on the CM4.
+*
+*******************************************************************************/
+bool DebugPort_IsDebuggerAttached(void)
+{
+    return (0u != (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk));
+}
+
+/*******************************************************************************
+* Function Name: DebugPort_IsReleased
+****************************************************************************//**
+*
+* Returns true if the debug port is released.
+*
+*******************************************************************************/
+bool DebugPort_IsReleased(void)
+{
+    return debugPortReleased;
+}
+
+#endif /* defined(PRODUCTION_MODE) */
+
+/* [] END OF FILE */
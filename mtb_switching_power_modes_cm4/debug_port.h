@@ -0,0 +1,68 @@
+/***************************************************************************//**
+* \file debug_port.h
+* \version 1.0
+*
+* \brief
+* Production mode: release of the debug port when no debugger is present.
+*
+* The device configuration keeps SWDIO, SWDCK and SWO on the CPUSS SWJ
+* function, and the access ports enabled, so a debugger can always attach and
+* power up the debug domain. In production, DebugPort_Init() releases them
+* instead: the three pins are switched to analog high-Z on the GPIO, and the
+* CM0+, CM4 and system access ports are disabled in CPUSS AP_CTL.
+*
+* The port is kept when:
+*  - a debugger is attached (C_DEBUGEN is set in the CM4 DHCSR), or
+*  - KIT_BTN1 is held down while the device comes out of reset. This is the
+*    gesture that brings the debug port back on a production unit.
+* DebugPort_Enable() also restores it at run time.
+*
+* Only the ENABLE bits of AP_CTL are cleared; the DISABLE bits would lock the
+* access ports until the next reset. The boot code enables them again after
+* every reset, so a programmer can still acquire the device.
+*
+* The trace enable in the DEMCR stays set, because the DWT cycle counter is
+* used by the boot profile and the wake-up statistics.
+*
+* The module is only built with PRODUCTION_MODE=1.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(DEBUG_PORT_H)
+#define DEBUG_PORT_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Access ports enabled by the boot code */
+#define DEBUG_PORT_AP_MASK  (CPUSS_AP_CTL_CM0_ENABLE_Msk | CPUSS_AP_CTL_CM4_ENABLE_Msk | \
+                             CPUSS_AP_CTL_SYS_ENABLE_Msk)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void DebugPort_Init(void);
+void DebugPort_Release(void);
+void DebugPort_Enable(void);
+bool DebugPort_IsDebuggerAttached(void);
+bool DebugPort_IsReleased(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DEBUG_PORT_H */
+
+/* [] END OF FILE */
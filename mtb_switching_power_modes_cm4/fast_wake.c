@@ -0,0 +1,299 @@
+/***************************************************************************//**
+* \file fast_wake.c
+* \version 1.0
+*
+* \brief
+* Fast wake-up from System Deep Sleep. See fast_wake.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "app_sections.h"
+#include "clock_manager.h"
+#include "cycle_counter.h"
+#include "pm_qos.h"
+#include "fast_wake.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* CLK_HF roots moved to the IMO: the CPUs and clk_peri, and the SMIF */
+#define FAST_WAKE_HF0           0u
+#define FAST_WAKE_HF2           2u
+
+/* Longest wait for the FLL to lock (in microseconds) */
+#define FAST_WAKE_LOCK_TIMEOUT  200000u
+
+typedef enum
+{
+    FAST_WAKE_FULL_SPEED    = 0u,   /* Clock roots on the FLL */
+    FAST_WAKE_ON_IMO        = 1u,   /* Clock roots on the IMO, FLL stopped */
+    FAST_WAKE_LOCKING       = 2u,   /* Clock roots on the IMO, FLL locking */
+} FastWakeState;
+
+/* SysPm callbacks: the clock roots go to the IMO after the peripherals are
+ * stopped, and are back on it before the peripherals restart. The FLL must
+ * be in use before the System LP and ULP clock changes; the PDL ignores the
+ * result of BEFORE_TRANSITION, so that is checked in CHECK_READY. */
+static const SysPmRegistryEntry fastWakeSysPmEntries[] =
+{
+    { FastWake_DeepSleepCallback, CY_SYSPM_DEEPSLEEP,
+      SYSPM_PHASE_BEFORE_TRANSITION | SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_CLOCK },
+    { FastWake_SystemModeCallback, CY_SYSPM_ULP, SYSPM_PHASE_CHECK_READY, SYSPM_PRIORITY_CLOCK },
+    { FastWake_SystemModeCallback, CY_SYSPM_LP, SYSPM_PHASE_CHECK_READY, SYSPM_PRIORITY_CLOCK },
+};
+
+const SysPmRegistryTable fastWakeSysPmTable =
+{
+    fastWakeSysPmEntries, sizeof(fastWakeSysPmEntries) / sizeof(fastWakeSysPmEntries[0])
+};
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static volatile FastWakeState fastWakeState = FAST_WAKE_FULL_SPEED;
+static uint32_t fastWakePeriDivider;        /* clk_peri divider at full speed */
+static bool fastWakeResumePending = false;  /* FastWake_Resumed() not called yet */
+static FastWakeStats fastWakeStats;
+
+
+/*******************************************************************************
+* Function Name: FastWake_SwitchToImo
+****************************************************************************//**
+*
+* Moves CLK_HF0 and CLK_HF2 to the IMO, with clk_peri undivided and the TCPWM
+* divider scaled to keep the peripheral clocks at their frequency.
+*
+*******************************************************************************/
+static APP_HOT void FastWake_SwitchToImo(void)
+{
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    fastWakePeriDivider = Cy_SysClk_ClkPeriGetDivider();
+    (void)Cy_SysClk_ClkHfSetSource(FAST_WAKE_HF0, FAST_WAKE_IMO_PATH);
+    (void)Cy_SysClk_ClkHfSetSource(FAST_WAKE_HF2, FAST_WAKE_IMO_PATH);
+    Cy_SysClk_ClkPeriSetDivider(0u);
+    ClockManager_SetDivider(CLOCK_MANAGER_CLK_TCPWM_DIV, FAST_WAKE_TCPWM_DIV_IMO);
+    SystemCoreClockUpdate();
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: FastWake_SwitchToFll
+****************************************************************************//**
+*
+* Moves CLK_HF0 and CLK_HF2 back to the locked FLL and restores the clk_peri
+* and TCPWM dividers. Records the time to full speed.
+*
+*******************************************************************************/
+static void FastWake_SwitchToFll(void)
+{
+    uint32_t interruptState;
+    uint32_t cycles;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    cycles = CycleCounter_Get();
+    ClockManager_SetDivider(CLOCK_MANAGER_CLK_TCPWM_DIV, FAST_WAKE_TCPWM_DIV_FULL);
+    Cy_SysClk_ClkPeriSetDivider((uint8_t)fastWakePeriDivider);
+    (void)Cy_SysClk_ClkHfSetSource(FAST_WAKE_HF0, FAST_WAKE_FLL_PATH);
+    (void)Cy_SysClk_ClkHfSetSource(FAST_WAKE_HF2, FAST_WAKE_FLL_PATH);
+    SystemCoreClockUpdate();
+    fastWakeState = FAST_WAKE_FULL_SPEED;
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    /* The cycles were counted from the IMO */
+    fastWakeStats.fullSpeedUs = cycles / FAST_WAKE_IMO_MHZ;
+    if (fastWakeStats.fullSpeedUs > fastWakeStats.maxFullSpeedUs)
+    {
+        fastWakeStats.maxFullSpeedUs = fastWakeStats.fullSpeedUs;
+    }
+}
+
+/*******************************************************************************
+* Function Name: FastWake_Resumed
+****************************************************************************//**
+*
+* Records the time to resume. Call as soon as Cy_SysPm_CpuEnterDeepSleep()
+* returns.
+*
+*******************************************************************************/
+void FastWake_Resumed(void)
+{
+    if (fastWakeResumePending)
+    {
+        fastWakeResumePending = false;
+
+        fastWakeStats.resumeUs = CycleCounter_Get() / FAST_WAKE_IMO_MHZ;
+        if (fastWakeStats.resumeUs > fastWakeStats.maxResumeUs)
+        {
+            fastWakeStats.maxResumeUs = fastWakeStats.resumeUs;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: FastWake_Process
+****************************************************************************//**
+*
+* Moves the clock roots back to the FLL once it has locked. Call from the main
+* loop; it never blocks.
+*
+*******************************************************************************/
+void FastWake_Process(void)
+{
+    if ((FAST_WAKE_LOCKING == fastWakeState) && Cy_SysClk_FllLocked())
+    {
+        FastWake_SwitchToFll();
+    }
+}
+
+/*******************************************************************************
+* Function Name: FastWake_Finish
+****************************************************************************//**
+*
+* Waits for the FLL to lock, up to FAST_WAKE_LOCK_TIMEOUT, and moves the clock
+* roots back to it. Returns true if they run from the FLL.
+*
+*******************************************************************************/
+bool FastWake_Finish(void)
+{
+    uint32_t timeoutUs;
+
+    for (timeoutUs = FAST_WAKE_LOCK_TIMEOUT;
+         (FAST_WAKE_LOCKING == fastWakeState) && !Cy_SysClk_FllLocked() && (0u != timeoutUs); timeoutUs--)
+    {
+        Cy_SysLib_DelayUs(1u);
+    }
+
+    FastWake_Process();
+
+    return (FAST_WAKE_FULL_SPEED == fastWakeState);
+}
+
+/*******************************************************************************
+* Function Name: FastWake_IsFullSpeed
+****************************************************************************//**
+*
+* Returns true if the clock roots run from the FLL.
+*
+*******************************************************************************/
+bool FastWake_IsFullSpeed(void)
+{
+    return (FAST_WAKE_FULL_SPEED == fastWakeState);
+}
+
+/*******************************************************************************
+* Function Name: FastWake_GetStats
+****************************************************************************//**
+*
+* Copies the wake-up statistics to stats.
+*
+*******************************************************************************/
+void FastWake_GetStats(FastWakeStats *stats)
+{
+    *stats = fastWakeStats;
+}
+
+/*******************************************************************************
+* Function Name: FastWake_DeepSleepCallback
+****************************************************************************//**
+*
+* Deep Sleep callback implementation. Before the transition it moves the clock
+* roots to the IMO and stops the FLL, so nothing waits for a lock on
+* wake-up. After the transition, its first step, it starts the cycle counter
+* and restarts the FLL without waiting for it to lock, unless a PM QoS clock
+* constraint is above the IMO frequency: then it waits for the lock and moves
+* the clock roots back before the application resumes.
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t FastWake_DeepSleepCallback(
+    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+
+    switch (mode)
+    {
+        case CY_SYSPM_BEFORE_TRANSITION:
+            /* Still on the IMO if the FLL has not locked since the last wake-up */
+            if (FAST_WAKE_FULL_SPEED == fastWakeState)
+            {
+                FastWake_SwitchToImo();
+            }
+            Cy_SysClk_FllDisable();
+            fastWakeState = FAST_WAKE_ON_IMO;
+
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            CycleCounter_Init();
+            fastWakeStats.wakeups++;
+            fastWakeResumePending = true;
+
+            /* With a zero timeout, the FLL is enabled without waiting for the
+             * lock. Nothing runs from path 0 until FastWake_Process(). */
+            (void)Cy_SysClk_FllEnable(0u);
+            fastWakeState = FAST_WAKE_LOCKING;
+
+            /* The IMO does not meet the clock constraint */
+            if (PmQos_GetMinClock() > FAST_WAKE_IMO_MHZ)
+            {
+                (void)FastWake_Finish();
+            }
+
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+/*******************************************************************************
+* Function Name: FastWake_SystemModeCallback
+****************************************************************************//**
+*
+* Enter System ULP and Exit System ULP callback implementation. In
+* CHECK_READY it completes a pending fast wake-up, because the System clock
+* changes reconfigure the FLL, and refuses the transition if the FLL does not
+* lock. The clock roots then stay on the IMO until FastWake_Process().
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t FastWake_SystemModeCallback(
+    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            retVal = FastWake_Finish() ? CY_SYSPM_SUCCESS : CY_SYSPM_FAIL;
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/***************************************************************************//**
+* \file fast_wake.h
+* \version 1.0
+*
+* \brief
+* Fast wake-up from System Deep Sleep.
+*
+* Before Deep Sleep, CLK_HF0 and CLK_HF2 are moved to path 1 (the IMO, 8 MHz)
+* and the FLL is stopped, so the CPU resumes at once after wake-up instead of
+* waiting for the FLL to lock. The FLL is restarted after wake-up and locks in
+* the background; FastWake_Process() moves the clock roots back to it once it
+* reports lock. While the CPU runs from the IMO, clk_peri is undivided and the
+* TCPWM clock divider is scaled, so the peripheral clocks keep their
+* frequency across the handover.
+*
+* While a PM QoS minimum clock above the IMO frequency is active (see
+* pm_qos.h), the wake-up waits for the lock instead, so the application never
+* runs below the constraint. The wait adds to the wake-up latency.
+*
+* The time from the first instruction after wake-up until the application
+* resumes, and until CLK_HF0 is back at full speed, is measured with the
+* cycle counter. The hardware wake-up before the first instruction is not
+* visible to the CPU and is not included.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(FAST_WAKE_H)
+#define FAST_WAKE_H
+
+#include "cy_pdl.h"
+#include "syspm_registry.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Clock path of the IMO, and of the FLL */
+#define FAST_WAKE_IMO_PATH          CY_SYSCLK_CLKHF_IN_CLKPATH1
+#define FAST_WAKE_FLL_PATH          CY_SYSCLK_CLKHF_IN_CLKPATH0
+#define FAST_WAKE_IMO_MHZ           8u
+
+/* TCPWM clock divider values: 500 kHz from clk_peri at 50 MHz (as in the
+ * design.modus), and from the IMO at 8 MHz */
+#define FAST_WAKE_TCPWM_DIV_FULL    99u
+#define FAST_WAKE_TCPWM_DIV_IMO     15u
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t wakeups;           /* Wake-ups from System Deep Sleep */
+    uint32_t resumeUs;          /* Last wake-up: first instruction to application */
+    uint32_t fullSpeedUs;       /* Last wake-up: first instruction to full CLK_HF0 */
+    uint32_t maxResumeUs;
+    uint32_t maxFullSpeedUs;
+} FastWakeStats;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const SysPmRegistryTable fastWakeSysPmTable;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void FastWake_Resumed(void);
+void FastWake_Process(void);
+bool FastWake_Finish(void);
+bool FastWake_IsFullSpeed(void);
+void FastWake_GetStats(FastWakeStats *stats);
+
+cy_en_syspm_status_t FastWake_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+cy_en_syspm_status_t FastWake_SystemModeCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* FAST_WAKE_H */
+
+/* [] END OF FILE */
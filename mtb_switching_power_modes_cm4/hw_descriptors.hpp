@@ -0,0 +1,59 @@
+/***************************************************************************//**
+* \file hw_descriptors.hpp
+* \version 1.0
+*
+* \brief
+* Descriptors of the configured pins and TCPWM counters (see hw_regs.hpp).
+*
+* Generated by tools/hwdesc/gen_hw_descriptors.py from cycfg_pins.h and
+* cycfg_peripherals.h. Do not edit.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(HW_DESCRIPTORS_HPP)
+#define HW_DESCRIPTORS_HPP
+
+#include "cycfg_pins.h"
+#include "cycfg_peripherals.h"
+#include "hw_regs.hpp"
+
+namespace hw
+{
+
+/* Pins (cycfg_pins.h) */
+using CybspWcoIn = Pin<CYBSP_WCO_IN_PORT_NUM, CYBSP_WCO_IN_NUM>;
+using CybspWcoOut = Pin<CYBSP_WCO_OUT_PORT_NUM, CYBSP_WCO_OUT_NUM>;
+using KitBtn1 = Pin<KIT_BTN1_PORT_NUM, KIT_BTN1_NUM>;
+using KitLed1 = Pin<KIT_LED1_PORT_NUM, KIT_LED1_NUM>;
+using CybspCsdTx = Pin<CYBSP_CSD_TX_PORT_NUM, CYBSP_CSD_TX_NUM>;
+using Ioss0Port6Pin0 = Pin<ioss_0_port_6_pin_0_PORT_NUM, ioss_0_port_6_pin_0_NUM>;
+using Ioss0Port6Pin1 = Pin<ioss_0_port_6_pin_1_PORT_NUM, ioss_0_port_6_pin_1_NUM>;
+using CybspSwo = Pin<CYBSP_SWO_PORT_NUM, CYBSP_SWO_NUM>;
+using CybspSwdio = Pin<CYBSP_SWDIO_PORT_NUM, CYBSP_SWDIO_NUM>;
+using CybspSwdck = Pin<CYBSP_SWDCK_PORT_NUM, CYBSP_SWDCK_NUM>;
+using CybspCina = Pin<CYBSP_CINA_PORT_NUM, CYBSP_CINA_NUM>;
+using CybspCinb = Pin<CYBSP_CINB_PORT_NUM, CYBSP_CINB_NUM>;
+using CybspCmod = Pin<CYBSP_CMOD_PORT_NUM, CYBSP_CMOD_NUM>;
+using CybspCsdBtn0 = Pin<CYBSP_CSD_BTN0_PORT_NUM, CYBSP_CSD_BTN0_NUM>;
+using CybspCsdBtn1 = Pin<CYBSP_CSD_BTN1_PORT_NUM, CYBSP_CSD_BTN1_NUM>;
+using CybspCsdSld0 = Pin<CYBSP_CSD_SLD0_PORT_NUM, CYBSP_CSD_SLD0_NUM>;
+using CybspCsdSld1 = Pin<CYBSP_CSD_SLD1_PORT_NUM, CYBSP_CSD_SLD1_NUM>;
+using CybspCsdSld2 = Pin<CYBSP_CSD_SLD2_PORT_NUM, CYBSP_CSD_SLD2_NUM>;
+using CybspCsdSld3 = Pin<CYBSP_CSD_SLD3_PORT_NUM, CYBSP_CSD_SLD3_NUM>;
+using CybspCsdSld4 = Pin<CYBSP_CSD_SLD4_PORT_NUM, CYBSP_CSD_SLD4_NUM>;
+
+/* TCPWM counters (cycfg_peripherals.h) */
+using AppCounter = TcpwmCounter<TCPWM0_BASE, APP_COUNTER_NUM>;
+using KitLed1Pwm = TcpwmCounter<TCPWM0_BASE, KIT_LED1_PWM_NUM>;
+
+} /* namespace hw */
+
+#endif /* HW_DESCRIPTORS_HPP */
+
+/* [] END OF FILE */
@@ -0,0 +1,155 @@
+/***************************************************************************//**
+* \file hw_regs.hpp
+* \version 1.0
+*
+* \brief
+* Compile-time descriptors of the GPIO pins and TCPWM counters (C++17).
+*
+* A descriptor is a type: the port, pin, TCPWM block and counter numbers are
+* template arguments, so the register addresses and masks are constants.
+* Every access is a static, always-inlined member that compiles to a single
+* load or store at a fixed address, with no base pointer or pin number
+* passed at run time and no assertions. The exception is
+* Pin::ClearInterrupt(), which reads the register back after the write, like
+* Cy_GPIO_ClearInterrupt(), so that the interrupt is cleared before the
+* handler returns.
+*
+* The descriptors of the configured pins and counters are generated from the
+* Device Configurator output into hw_descriptors.hpp. They only replace the
+* PDL accessors on hot paths; the peripherals are still initialized with the
+* PDL and the generated configuration structures.
+*
+* Only the accessors that the hot paths use are provided. The register
+* layouts are those of the GPIO and TCPWM (v1) blocks of the PSoC 6 devices.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(HW_REGS_HPP)
+#define HW_REGS_HPP
+
+#include "cy_pdl.h"
+
+namespace hw
+{
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* GPIO pin PinNum of port PortNum */
+template <uint32_t PortNum, uint32_t PinNum>
+struct Pin
+{
+    static_assert(PinNum < CY_GPIO_PINS_MAX, "Pin number out of range");
+
+    static constexpr uint32_t portNum = PortNum;
+    static constexpr uint32_t pinNum = PinNum;
+    static constexpr uint32_t mask = 1UL << PinNum;
+
+    __STATIC_FORCEINLINE GPIO_PRT_Type *Port()
+    {
+        return &GPIO->PRT[PortNum];
+    }
+
+    /* Input level, 0 or 1 (Cy_GPIO_Read) */
+    __STATIC_FORCEINLINE uint32_t Read()
+    {
+        return (Port()->IN >> PinNum) & 1UL;
+    }
+
+    __STATIC_FORCEINLINE void Set()
+    {
+        Port()->OUT_SET = mask;
+    }
+
+    __STATIC_FORCEINLINE void Clr()
+    {
+        Port()->OUT_CLR = mask;
+    }
+
+    __STATIC_FORCEINLINE void Inv()
+    {
+        Port()->OUT_INV = mask;
+    }
+
+    /* Masked interrupt status, 0 or 1 (Cy_GPIO_GetInterruptStatusMasked) */
+    __STATIC_FORCEINLINE uint32_t GetInterruptStatusMasked()
+    {
+        return (Port()->INTR_MASKED >> PinNum) & 1UL;
+    }
+
+    /* Cy_GPIO_ClearInterrupt */
+    __STATIC_FORCEINLINE void ClearInterrupt()
+    {
+        Port()->INTR = mask;
+        (void)Port()->INTR;
+    }
+};
+
+/* Counter CntNum of the TCPWM block at address Base */
+template <uintptr_t Base, uint32_t CntNum>
+struct TcpwmCounter
+{
+    static_assert(CntNum < 32u, "Counter number out of range");
+
+    static constexpr uint32_t cntNum = CntNum;
+    static constexpr uint32_t mask = 1UL << CntNum;
+
+    __STATIC_FORCEINLINE TCPWM_Type *Block()
+    {
+        return reinterpret_cast<TCPWM_Type *>(Base);
+    }
+
+    __STATIC_FORCEINLINE TCPWM_CNT_Type *Cnt()
+    {
+        return &Block()->CNT[CntNum];
+    }
+
+    __STATIC_FORCEINLINE bool IsRunning()
+    {
+        return 0u != (Cnt()->STATUS & TCPWM_CNT_STATUS_RUNNING_Msk);
+    }
+
+    __STATIC_FORCEINLINE uint32_t GetCounter()
+    {
+        return Cnt()->COUNTER;
+    }
+
+    __STATIC_FORCEINLINE void SetCounter(uint32_t count)
+    {
+        Cnt()->COUNTER = count;
+    }
+
+    /* Cy_TCPWM_PWM_SetPeriod0 */
+    __STATIC_FORCEINLINE void SetPeriod0(uint32_t period)
+    {
+        Cnt()->PERIOD = period;
+    }
+
+    /* Cy_TCPWM_PWM_SetCompare0, Cy_TCPWM_Counter_SetCompare0 */
+    __STATIC_FORCEINLINE void SetCompare0(uint32_t compare)
+    {
+        Cnt()->CC = compare;
+    }
+
+    __STATIC_FORCEINLINE void TriggerStart()
+    {
+        Block()->CMD_START = mask;
+    }
+
+    __STATIC_FORCEINLINE void TriggerStopOrKill()
+    {
+        Block()->CMD_STOP = mask;
+    }
+};
+
+} /* namespace hw */
+
+#endif /* HW_REGS_HPP */
+
+/* [] END OF FILE */
@@ -0,0 +1,209 @@
+/***************************************************************************//**
+* \file io_bench.cpp
+* \version 1.0
+*
+* \brief
+* Benchmark of the register accesses on the hot paths. See io_bench.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if defined(IO_BENCH)
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "cycle_counter.h"
+#include "hw_descriptors.hpp"
+#include "io_bench.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* LED PWM period of the System LP blink pattern (LED_BLINK_FAST in main.c) */
+#define IO_BENCH_LED_PERIOD     50000u
+
+typedef uint32_t (*IoBenchProbe)(uint32_t value);
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+volatile IoBenchResult ioBenchResult;
+
+/* Keeps the probe results alive */
+static volatile uint32_t ioBenchSink;
+
+
+/*******************************************************************************
+* Function Name: IoBench_Empty
+****************************************************************************//**
+*
+* Empty probe routine.
+*
+*******************************************************************************/
+static CY_NOINLINE uint32_t IoBench_Empty(uint32_t value)
+{
+    return value;
+}
+
+/*******************************************************************************
+* Function Name: IoBench_IsrPdl
+****************************************************************************//**
+*
+* Wake-up interrupt handler path, PDL accessors.
+*
+*******************************************************************************/
+static CY_NOINLINE uint32_t IoBench_IsrPdl(uint32_t value)
+{
+    uint32_t pending = Cy_GPIO_GetInterruptStatusMasked(KIT_BTN1_PORT, KIT_BTN1_NUM);
+
+    Cy_GPIO_ClearInterrupt(KIT_BTN1_PORT, KIT_BTN1_NUM);
+
+    return pending + value;
+}
+
+/*******************************************************************************
+* Function Name: IoBench_IsrDescriptor
+****************************************************************************//**
+*
+* Wake-up interrupt handler path, descriptors.
+*
+*******************************************************************************/
+static CY_NOINLINE uint32_t IoBench_IsrDescriptor(uint32_t value)
+{
+    uint32_t pending = hw::KitBtn1::GetInterruptStatusMasked();
+
+    hw::KitBtn1::ClearInterrupt();
+
+    return pending + value;
+}
+
+/*******************************************************************************
+* Function Name: IoBench_PollPdl
+****************************************************************************//**
+*
+* Press timing path, PDL accessors.
+*
+*******************************************************************************/
+static CY_NOINLINE uint32_t IoBench_PollPdl(uint32_t value)
+{
+    uint32_t acc = Cy_GPIO_Read(KIT_BTN1_PORT, KIT_BTN1_NUM);
+
+    acc += Cy_TCPWM_Counter_GetStatus(APP_COUNTER_HW, APP_COUNTER_NUM) & CY_TCPWM_COUNTER_STATUS_COUNTER_RUNNING;
+    acc += Cy_TCPWM_Counter_GetCounter(APP_COUNTER_HW, APP_COUNTER_NUM);
+
+    return acc + value;
+}
+
+/*******************************************************************************
+* Function Name: IoBench_PollDescriptor
+****************************************************************************//**
+*
+* Press timing path, descriptors.
+*
+*******************************************************************************/
+static CY_NOINLINE uint32_t IoBench_PollDescriptor(uint32_t value)
+{
+    uint32_t acc = hw::KitBtn1::Read();
+
+    acc += hw::AppCounter::IsRunning() ? 1u : 0u;
+    acc += hw::AppCounter::GetCounter();
+
+    return acc + value;
+}
+
+/*******************************************************************************
+* Function Name: IoBench_CallbackPdl
+****************************************************************************//**
+*
+* Blink pattern change of the power callbacks (PWM_LED_ACTION), PDL
+* accessors.
+*
+*******************************************************************************/
+static CY_NOINLINE uint32_t IoBench_CallbackPdl(uint32_t value)
+{
+    Cy_TCPWM_PWM_SetPeriod0(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM, value);
+    Cy_TCPWM_PWM_SetCompare0(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM, value / 2u);
+    Cy_TCPWM_PWM_SetCounter(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM, 0u);
+
+    return value;
+}
+
+/*******************************************************************************
+* Function Name: IoBench_CallbackDescriptor
+****************************************************************************//**
+*
+* Blink pattern change of the power callbacks, descriptors.
+*
+*******************************************************************************/
+static CY_NOINLINE uint32_t IoBench_CallbackDescriptor(uint32_t value)
+{
+    hw::KitLed1Pwm::SetPeriod0(value);
+    hw::KitLed1Pwm::SetCompare0(value / 2u);
+    hw::KitLed1Pwm::SetCounter(0u);
+
+    return value;
+}
+
+/*******************************************************************************
+* Function Name: IoBench_Measure
+****************************************************************************//**
+*
+* Returns the cycles taken by one call of probe, with interrupts disabled.
+* The first call warms up the flash cache and is not counted.
+*
+*******************************************************************************/
+static uint32_t IoBench_Measure(IoBenchProbe probe, uint32_t value)
+{
+    uint32_t interruptState;
+    uint32_t start;
+    uint32_t result;
+    uint32_t cycles;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    result = probe(value);
+
+    start = CycleCounter_Get();
+    result += probe(value);
+    cycles = CycleCounter_Get() - start;
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    ioBenchSink += result;
+
+    return cycles;
+}
+
+/*******************************************************************************
+* Function Name: IoBench_Run
+****************************************************************************//**
+*
+* Times each path through the PDL and through the descriptors, in the
+* current power mode (System LP at startup).
+*
+*******************************************************************************/
+extern "C" void IoBench_Run(void)
+{
+    /* The cycle counter runs from reset (see boot_profile.h) */
+    ioBenchResult.empty = IoBench_Measure(IoBench_Empty, 0u);
+
+    ioBenchResult.isr.pdl = IoBench_Measure(IoBench_IsrPdl, 0u);
+    ioBenchResult.isr.descriptor = IoBench_Measure(IoBench_IsrDescriptor, 0u);
+
+    ioBenchResult.poll.pdl = IoBench_Measure(IoBench_PollPdl, 0u);
+    ioBenchResult.poll.descriptor = IoBench_Measure(IoBench_PollDescriptor, 0u);
+
+    ioBenchResult.callback.pdl = IoBench_Measure(IoBench_CallbackPdl, IO_BENCH_LED_PERIOD);
+    ioBenchResult.callback.descriptor = IoBench_Measure(IoBench_CallbackDescriptor, IO_BENCH_LED_PERIOD);
+}
+
+#endif /* defined(IO_BENCH) */
+
+/* [] END OF FILE */
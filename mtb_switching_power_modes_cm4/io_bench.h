@@ -0,0 +1,77 @@
+/***************************************************************************//**
+* \file io_bench.h
+* \version 1.0
+*
+* \brief
+* Benchmark of the register accesses on the hot paths, through the PDL and
+* through the descriptors of hw_regs.hpp. Each path is a probe routine timed
+* with the CPU cycle counter in System LP:
+*  - isr: the wake-up interrupt handler, masked status and clear of KIT_BTN1.
+*  - poll: the press timing of GetSwitchEvent(), KIT_BTN1 level, status and
+*    count of the switch counter.
+*  - callback: the blink pattern change of the power callbacks, period,
+*    compare and count of the LED PWM.
+* The empty probe gives the call overhead, to subtract from the others.
+* Results are left in ioBenchResult for inspection with the debugger, and
+* make iobenchreport lists the code size of each probe.
+*
+* The PDL accessors are inline functions too, so in a Release build both
+* variants should be close. In a Debug build the PDL ones are calls with
+* their parameter checks.
+*
+* Build with IO_BENCH=1 to run the benchmark at startup. It rewrites the
+* LED PWM with the System LP blink pattern and clears a pending KIT_BTN1
+* interrupt.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(IO_BENCH_H)
+#define IO_BENCH_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Cycles of one call of a probe routine */
+typedef struct
+{
+    uint32_t pdl;           /* PDL accessors */
+    uint32_t descriptor;    /* hw_regs.hpp descriptors */
+} IoBenchCycles;
+
+typedef struct
+{
+    uint32_t empty;         /* Empty probe, call overhead */
+    IoBenchCycles isr;
+    IoBenchCycles poll;
+    IoBenchCycles callback;
+} IoBenchResult;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern volatile IoBenchResult ioBenchResult;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void IoBench_Run(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IO_BENCH_H */
+
+/* [] END OF FILE */
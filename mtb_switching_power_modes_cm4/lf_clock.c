@@ -0,0 +1,110 @@
+/***************************************************************************//**
+* \file lf_clock.c
+* \version 1.0
+*
+* \brief
+* Non-blocking start-up of the 32.768 kHz watch crystal. See lf_clock.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "boot_profile.h"
+#include "lf_clock.h"
+#include "time_base.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static LfClockState lfClockState = LF_CLOCK_ON_ILO;
+static uint64_t lfClockStartTicks;
+
+
+/*******************************************************************************
+* Function Name: LfClock_SwitchToWco
+****************************************************************************//**
+*
+* Moves clk_lf to the WCO.
+*
+*******************************************************************************/
+static void LfClock_SwitchToWco(void)
+{
+    /* The WDT is unlocked in the default startup code */
+    Cy_SysClk_ClkLfSetSource(CY_SYSCLK_CLKLF_IN_WCO);
+    TimeBase_SetClockHz(TIME_BASE_WCO_HZ);
+    lfClockState = LF_CLOCK_ON_WCO;
+    BootProfile_Mark(BOOT_PROFILE_CM4_WCO);
+}
+
+/*******************************************************************************
+* Function Name: LfClock_Init
+****************************************************************************//**
+*
+* Enables the WCO. Call after TimeBase_Init().
+*
+*******************************************************************************/
+void LfClock_Init(void)
+{
+#if defined(LF_CLOCK_WCO_ASYNC)
+    /* With a zero timeout, the WCO is enabled without waiting for it */
+    (void)Cy_SysClk_WcoEnable(0u);
+    lfClockStartTicks = TimeBase_GetTicks();
+#else
+    if (CY_SYSCLK_SUCCESS == Cy_SysClk_WcoEnable(LF_CLOCK_WCO_TIMEOUT_MS * 1000u))
+    {
+        LfClock_SwitchToWco();
+    }
+    else
+    {
+        lfClockState = LF_CLOCK_WCO_FAILED;
+    }
+#endif /* defined(LF_CLOCK_WCO_ASYNC) */
+}
+
+/*******************************************************************************
+* Function Name: LfClock_Process
+****************************************************************************//**
+*
+* Moves clk_lf to the WCO once it is stable, or gives up after
+* LF_CLOCK_WCO_TIMEOUT_MS. Call from the main loop; it never blocks.
+*
+*******************************************************************************/
+void LfClock_Process(void)
+{
+    if (LF_CLOCK_ON_ILO == lfClockState)
+    {
+        if (Cy_SysClk_WcoOkay())
+        {
+            LfClock_SwitchToWco();
+        }
+        else if ((TimeBase_GetTicks() - lfClockStartTicks) > TIME_BASE_MS_TO_TICKS(LF_CLOCK_WCO_TIMEOUT_MS))
+        {
+            Cy_SysClk_WcoDisable();
+            lfClockState = LF_CLOCK_WCO_FAILED;
+        }
+        else
+        {
+            /* Still starting */
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: LfClock_GetState
+****************************************************************************//**
+*
+* Returns the source of clk_lf.
+*
+*******************************************************************************/
+LfClockState LfClock_GetState(void)
+{
+    return lfClockState;
+}
+
+/* [] END OF FILE */
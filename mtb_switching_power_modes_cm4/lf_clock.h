@@ -0,0 +1,67 @@
+/***************************************************************************//**
+* \file lf_clock.h
+* \version 1.0
+*
+* \brief
+* Non-blocking start-up of the 32.768 kHz watch crystal (WCO).
+*
+* The device configuration starts clk_lf on the ILO, so the clock
+* configuration no longer waits for the crystal to stabilize, which can take
+* hundreds of milliseconds. LfClock_Init() enables the WCO without waiting,
+* and LfClock_Process() moves clk_lf to it from the main loop once the WCO
+* reports it is stable. The SRSS has no WCO-ready interrupt, so the switch is
+* polled.
+*
+* Until the switch, clk_lf runs at 32 kHz with the ILO accuracy (+/-30%). The
+* time base converts at the rate of the selected source (see time_base.h),
+* but the telemetry timestamps taken before the switch are approximate. If
+* the WCO is not stable after LF_CLOCK_WCO_TIMEOUT_MS, clk_lf stays on the
+* ILO.
+*
+* With WCO_ASYNC=0, LfClock_Init() waits for the WCO and switches at once,
+* like the original clock configuration did.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(LF_CLOCK_H)
+#define LF_CLOCK_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Longest wait for the WCO to become stable (in milliseconds) */
+#define LF_CLOCK_WCO_TIMEOUT_MS     1000u
+
+typedef enum
+{
+    LF_CLOCK_ON_ILO         = 0u,   /* clk_lf on the ILO, WCO starting */
+    LF_CLOCK_ON_WCO         = 1u,   /* clk_lf on the WCO */
+    LF_CLOCK_WCO_FAILED     = 2u,   /* WCO not stable in time, clk_lf on the ILO */
+} LfClockState;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void LfClock_Init(void);
+void LfClock_Process(void);
+LfClockState LfClock_GetState(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* LF_CLOCK_H */
+
+/* [] END OF FILE */
@@ -17,9 +17,39 @@
 *******************************************************************************/
 
 #include "cy_pdl.h"
+#if defined(CY_USING_HAL)
 #include "cyhal.h"
+#endif /* defined(CY_USING_HAL) */
 #include "cybsp.h"
 #include "cycfg.h"
+#include "alive_led.h"
+#include "boot_profile.h"
+#include "boot_sync.h"
+#include "app_sections.h"
+#include "clock_manager.h"
+#include "debug_port.h"
+#include "fast_wake.h"
+#include "lf_clock.h"
+#include "runtime_pm.h"
+#include "pin_park.h"
+#include "pm_qos.h"
+#include "regulator.h"
+#include "reg_context.h"
+#include "smif_mem.h"
+#include "sram_retention.h"
+#include "stack_watch.h"
+#include "syspm_registry.h"
+#include "time_base.h"
+#include "telemetry_log.h"
+#if defined(SECTION_BENCH)
+#include "section_bench.h"
+#endif /* defined(SECTION_BENCH) */
+#if defined(IO_BENCH)
+#include "io_bench.h"
+#endif /* defined(IO_BENCH) */
+#if defined(PM_CALIBRATION)
+#include "pm_calibration.h"
+#endif /* defined(PM_CALIBRATION) */
 
 
 /*******************************************************************************
@@ -61,11 +91,59 @@ typedef enum
                             Cy_TCPWM_PWM_SetCompare0(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM, x); \
                             Cy_TCPWM_PWM_SetCounter(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM, 0);
 
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* A button press is being timed, the switch counter is in use */
+static bool switchCounterHeld = false;
+
+/* A quick press asked for a System mode change that was refused, retried
+ * from the main loop */
+static bool systemModeSwitchPending = false;
+
+/* Context of the LED PWM that the sleep callbacks take over: the blink
+ * pattern and its phase. The period goes back first, so that the counter is
+ * never restored above it. */
+static const RegContextRange ledPwmContextRanges[] =
+{
+    { &KIT_LED1_PWM_HW->CNT[KIT_LED1_PWM_NUM].PERIOD, 1u },
+    { &KIT_LED1_PWM_HW->CNT[KIT_LED1_PWM_NUM].CC, 1u },
+    { &KIT_LED1_PWM_HW->CNT[KIT_LED1_PWM_NUM].COUNTER, 1u },
+};
+
+static uint32_t ledPwmSnapshot[sizeof(ledPwmContextRanges) / sizeof(ledPwmContextRanges[0])];
+
+static const RegContext ledPwmContext =
+{
+    ledPwmContextRanges, sizeof(ledPwmContextRanges) / sizeof(ledPwmContextRanges[0]), ledPwmSnapshot
+};
+
+#if defined(CY_USING_HAL)
+/* Clock path muxes that init_cycfg_system() configures on the CM0+, which
+ * is built without the HAL. They are reserved in the HAL of the CM4. */
+static const cyhal_resource_inst_t *const systemClockResources[] =
+{
+    &srss_0_clock_0_pathmux_0_obj,
+    &srss_0_clock_0_pathmux_1_obj,
+    &srss_0_clock_0_pathmux_2_obj,
+    &srss_0_clock_0_pathmux_3_obj,
+    &srss_0_clock_0_pathmux_4_obj,
+    &srss_0_clock_0_pathmux_5_obj,
+};
+#endif /* defined(CY_USING_HAL) */
+
+
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
 /* Auxiliary Prototype functions */
 SwitchEvent GetSwitchEvent(void);
+SwitchEvent ClassifySwitchPress(uint32_t pressCount);
+void StartSwitchCounter(void);
+void StopSwitchCounter(void);
+bool SwitchSystemMode(void);
+TelemetryMode GetActiveMode(void);
+void LogStackHighWater(void);
 void WakeupInterruptHandler(void);
 
 /* Callback Prototypes */
@@ -77,36 +155,150 @@ cy_en_syspm_status_t Clock_EnterUltraLowPowerCallback(cy_stc_syspm_callback_para
 cy_en_syspm_status_t Clock_ExitUltraLowPowerCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
 
 
+/*******************************************************************************
+* SysPm Callback Tables
+*******************************************************************************/
+/* Callbacks of the application: LED patterns and the CLK_HF0 frequency */
+static const SysPmRegistryEntry mainSysPmEntries[] =
+{
+    { TCPWM_SleepCallback, CY_SYSPM_SLEEP,
+      SYSPM_PHASE_BEFORE_TRANSITION | SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_PERIPHERAL },
+    { TCPWM_DeepSleepCallback, CY_SYSPM_DEEPSLEEP,
+      SYSPM_PHASE_BEFORE_TRANSITION | SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_PERIPHERAL },
+    { TCPWM_EnterUltraLowPowerCallback, CY_SYSPM_ULP,
+      SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_PERIPHERAL },
+    { TCPWM_ExitUltraLowPowerCallback, CY_SYSPM_LP,
+      SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_PERIPHERAL },
+    { Clock_EnterUltraLowPowerCallback, CY_SYSPM_ULP,
+      SYSPM_PHASE_BEFORE_TRANSITION, SYSPM_PRIORITY_CLOCK },
+    { Clock_ExitUltraLowPowerCallback, CY_SYSPM_LP,
+      SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_CLOCK },
+};
+
+static const SysPmRegistryTable mainSysPmTable =
+{
+    mainSysPmEntries, sizeof(mainSysPmEntries) / sizeof(mainSysPmEntries[0])
+};
+
+/* All subsystems. Equal priorities keep this order. */
+static const SysPmRegistryTable *const sysPmTables[] =
+{
+    &pmQosSysPmTable,
+    &fastWakeSysPmTable,
+    &mainSysPmTable,
+    &smifMemSysPmTable,
+#if defined(PIN_PARK)
+    &pinParkSysPmTable,
+#endif /* defined(PIN_PARK) */
+#if defined(SRAM_RETENTION)
+    &sramRetentionSysPmTable,
+#endif /* defined(SRAM_RETENTION) */
+    &clockManagerSysPmTable,
+};
+
+
 /*******************************************************************************
 * Function Name: main
 ****************************************************************************//**
 *
 *  Initialization:
+*  - Configure the pins and peripherals while the CM0+ configures the clocks.
+*  - In production builds, release the debug port if no debugger is attached.
+*  - Start the WCO without waiting for it.
+*  - Stop the unused clock roots.
+*  - Enable the SIMO buck, if fitted.
+*  - Initialize the external QSPI memory and the telemetry log.
 *  - Register sleep callbacks.
 *  - Initialize the PWM block that controls the LED brightness.
 *  Do forever loop:
 *  - Check if KIT_BTN1 was pressed and for how long.
-*  - If quickly pressed, swap from LP to ULP (vice-versa).
+*  - If quickly pressed, swap from LP to ULP (vice-versa). If the swap is
+*    refused (QSPI erase in progress), retry it until it succeeds or the
+*    button is quickly pressed again.
 *  - If short pressed, go to sleep.
-*  - If long pressed, go to deep sleep.
+*  - If long pressed, go to deep sleep (or sleep, if a PM QoS latency
+*    constraint does not allow deep sleep).
+*  - After deep sleep, run from the IMO until the FLL has locked.
+*  - Move clk_lf to the WCO once it is stable.
+*  - Record power mode transitions and write the telemetry log.
+*  - Before the CPU sleeps, record the stack high-water marks of both cores.
 *
 *******************************************************************************/
 int main(void)
 {
-    cy_rslt_t result;
-
-    /* Initialize the device and board peripherals */
-    result = cybsp_init() ;
-    if (result != CY_RSLT_SUCCESS)
+    bool deepSleep;
+#if defined(CY_USING_HAL)
+    uint32_t i;
+#endif /* defined(CY_USING_HAL) */
+
+    /* Record the boot stages, see boot_profile.h */
+    BootProfile_Mark(BOOT_PROFILE_CM4_MAIN);
+
+    /* Paint the stack to measure its high-water mark */
+    StackWatch_Init();
+
+    /* Initialize the board peripherals. The CM0+ configures the power system
+     * and the clocks meanwhile (see boot_sync.h), so this replaces
+     * cybsp_init(). Nothing here depends on the clock frequencies. The CM0+
+     * is built without the HAL, so the system clocks it configures are
+     * reserved here. Without the HAL (LEAN_BUILD=1), the generated code
+     * reserves no resources. */
+#if defined(CY_USING_HAL)
+    if (CY_RSLT_SUCCESS != cyhal_hwmgr_init())
+    {
+        CY_ASSERT(0);
+    }
+    for (i = 0u; i < (sizeof(systemClockResources) / sizeof(systemClockResources[0])); i++)
+    {
+        (void)cyhal_hwmgr_reserve(systemClockResources[i]);
+    }
+#endif /* defined(CY_USING_HAL) */
+    init_cycfg_clocks();
+    init_cycfg_routing();
+    init_cycfg_peripherals();
+    init_cycfg_pins();
+#if defined(PIN_PARK)
+    PinPark_Init();
+#endif /* defined(PIN_PARK) */
+#if defined(PRODUCTION_MODE)
+    /* Release the debug port, unless a debugger is attached or KIT_BTN1 is
+     * held down */
+    DebugPort_Init();
+#endif /* defined(PRODUCTION_MODE) */
+    BootProfile_Mark(BOOT_PROFILE_CM4_BOARD);
+
+    /* Wait for the clocks */
+    BootSync_Wait(BOOT_SYNC_CLOCKS_READY);
+    SystemCoreClockUpdate();
+    BootProfile_Mark(BOOT_PROFILE_CM4_CLOCKS_READY);
+
+    /* Stop the clock roots and PLLs that the application does not use */
+    ClockManager_Init();
+
+    /* Enable the SIMO buck, if fitted */
+    Regulator_Init();
+    BootProfile_Mark(BOOT_PROFILE_CM4_CLOCK_MANAGER);
+
+    /* Initialize the external QSPI memory */
+    if (CY_SMIF_SUCCESS != SmifMem_Init())
     {
         CY_ASSERT(0);
     }
+    BootProfile_Mark(BOOT_PROFILE_CM4_SMIF);
 
-    /* SysPm callback params */
-    cy_stc_syspm_callback_params_t callbackParams = {
-        /*.base       =*/ NULL,
-        /*.context    =*/ NULL
-    };
+    /* Start the LF time base and recover the telemetry log */
+    TimeBase_Init();
+    LfClock_Init();
+    RuntimePm_Init();
+
+    /* TelemetryLog_Init() is cold code, keep the QSPI memory mapped */
+    RuntimePm_Get(RUNTIME_PM_DEV_SMIF);
+    if (!TelemetryLog_Init())
+    {
+        CY_ASSERT(0);
+    }
+    RuntimePm_Put(RUNTIME_PM_DEV_SMIF);
+    BootProfile_Mark(BOOT_PROFILE_CM4_TELEMETRY);
 
     /* Wake-up Interrupt pin config structure (P0[4]) */
     cy_stc_sysint_t WakeupIsrPin =
@@ -116,48 +308,6 @@ int main(void)
         .intrPriority = 0,
     };
 
-    /* Callback declaration for Power Modes */
-    cy_stc_syspm_callback_t PwmSleepCb = {TCPWM_SleepCallback,      /* Callback function */
-                                          CY_SYSPM_SLEEP,           /* Callback type */
-                                          CY_SYSPM_SKIP_CHECK_READY |
-                                          CY_SYSPM_SKIP_CHECK_FAIL, /* Skip mode */
-                                          &callbackParams,          /* Callback params */
-                                          NULL, NULL};              /* For internal usage */
-    cy_stc_syspm_callback_t PwmDeepSleepCb = {TCPWM_DeepSleepCallback,  /* Callback function */
-                                              CY_SYSPM_DEEPSLEEP,       /* Callback type */
-                                              CY_SYSPM_SKIP_CHECK_READY |
-                                              CY_SYSPM_SKIP_CHECK_FAIL, /* Skip mode */
-                                              &callbackParams,          /* Callback params */
-                                              NULL, NULL};              /* For internal usage */
-    cy_stc_syspm_callback_t PwmEnterUlpCb = {TCPWM_EnterUltraLowPowerCallback, /* Callback function */
-                                             CY_SYSPM_ULP,                     /* Callback type */
-                                             CY_SYSPM_SKIP_CHECK_READY |
-                                             CY_SYSPM_SKIP_CHECK_FAIL |
-                                             CY_SYSPM_SKIP_BEFORE_TRANSITION,  /* Skip mode */
-                                             &callbackParams,                  /* Callback params */
-                                             NULL, NULL};                      /* For internal usage */
-    cy_stc_syspm_callback_t PwmExitUlpCb = {TCPWM_ExitUltraLowPowerCallback, /* Callback function */
-                                            CY_SYSPM_LP,                     /* Callback type */
-                                            CY_SYSPM_SKIP_CHECK_READY |
-                                            CY_SYSPM_SKIP_CHECK_FAIL |
-                                            CY_SYSPM_SKIP_BEFORE_TRANSITION, /* Skip mode */
-                                            &callbackParams,                 /* Callback params */
-                                            NULL, NULL};                     /* For internal usage */
-    cy_stc_syspm_callback_t ClkEnterUlpCb = {Clock_EnterUltraLowPowerCallback, /* Callback function */
-                                             CY_SYSPM_ULP,                     /* Callback type */
-                                             CY_SYSPM_SKIP_CHECK_READY |
-                                             CY_SYSPM_SKIP_CHECK_FAIL |
-                                             CY_SYSPM_SKIP_AFTER_TRANSITION,   /* Skip mode */
-                                             &callbackParams,                  /* Callback params */
-                                             NULL, NULL};
-    cy_stc_syspm_callback_t ClkExitUlpCb = {Clock_ExitUltraLowPowerCallback, /* Callback function */
-                                            CY_SYSPM_LP,                     /* Callback type */
-                                            CY_SYSPM_SKIP_CHECK_READY |
-                                            CY_SYSPM_SKIP_CHECK_FAIL |
-                                            CY_SYSPM_SKIP_BEFORE_TRANSITION, /* Skip mode */
-                                            &callbackParams,                 /* Callback params */
-                                            NULL, NULL};                     /* For internal usage */
-
     /* enable interrupts */
     __enable_irq();
 
@@ -170,50 +320,85 @@ int main(void)
     /* Enable ISR to wake up pin */
     NVIC_EnableIRQ(WakeupIsrPin.intrSrc);
 
-    /* Register SysPm callbacks */
-    Cy_SysPm_RegisterCallback(&PwmSleepCb);
-    Cy_SysPm_RegisterCallback(&PwmDeepSleepCb);
-    Cy_SysPm_RegisterCallback(&PwmEnterUlpCb);
-    Cy_SysPm_RegisterCallback(&PwmExitUlpCb);
-    Cy_SysPm_RegisterCallback(&ClkEnterUlpCb);
-    Cy_SysPm_RegisterCallback(&ClkExitUlpCb);
+#if defined(SRAM_RETENTION)
+    /* Find the SRAM macros that need no retention in Deep Sleep */
+    SramRetention_Init();
+#endif /* defined(SRAM_RETENTION) */
+
+    /* Register the SysPm callbacks of all subsystems, in priority order */
+    SysPmRegistry_Init(sysPmTables, sizeof(sysPmTables) / sizeof(sysPmTables[0]));
+    BootProfile_Mark(BOOT_PROFILE_CM4_CALLBACKS);
 
     /* Initialize the TCPWM blocks */
     Cy_TCPWM_PWM_Init(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM, &KIT_LED1_PWM_config);
     Cy_TCPWM_Counter_Init(APP_COUNTER_HW, APP_COUNTER_NUM, &APP_COUNTER_config);
 
     /* Enable the PWM LED */
-    Cy_TCPWM_PWM_Enable(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM);
-    Cy_TCPWM_TriggerStart(KIT_LED1_PWM_HW, KIT_LED1_PWM_MASK);
+    RuntimePm_Get(RUNTIME_PM_DEV_LED_PWM);
+    BootProfile_Mark(BOOT_PROFILE_CM4_TCPWM);
+
+#if defined(PM_CALIBRATION)
+    /* The transitions are timed with clk_lf, so it must run from the WCO */
+    while (LF_CLOCK_ON_ILO == LfClock_GetState())
+    {
+        LfClock_Process();
+    }
+
+    /* Load the transition costs, or measure them on the first boot */
+    (void)PmCalibration_Init();
+#endif /* defined(PM_CALIBRATION) */
+
+#if defined(SECTION_BENCH)
+    /* Time the code placements in LP and ULP, see sectionBenchResult */
+    SectionBench_Run();
+#endif /* defined(SECTION_BENCH) */
+
+#if defined(IO_BENCH)
+    /* Time the hot-path register accesses, see ioBenchResult */
+    IoBench_Run();
+#endif /* defined(IO_BENCH) */
+
+    BootProfile_Mark(BOOT_PROFILE_CM4_READY);
 
     for (;;)
     {
         switch (GetSwitchEvent())
         {
             case SWITCH_QUICK_PRESS:
-                /* Check if the device is in System ULP mode */
-                if (Cy_SysPm_IsSystemUlp())
-                {
-                    /* Switch to System LP mode */
-                    Cy_SysPm_SystemEnterLp();
-                }
-                else
-                {
-                    /* Switch to ULP mode */
-                    Cy_SysPm_SystemEnterUlp();
-                }
+                /* A second press while a swap is pending cancels it */
+                systemModeSwitchPending = !systemModeSwitchPending;
                 break;
 
             case SWITCH_SHORT_PRESS:
+                LogStackHighWater();
+
                 /* Go to sleep */
+                TelemetryLog_SetMode(Cy_SysPm_IsSystemUlp() ? TELEMETRY_MODE_ULP_SLEEP : TELEMETRY_MODE_LP_SLEEP);
                 Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+                TelemetryLog_SetMode(GetActiveMode());
                 /* Wait a bit to avoid glitches in the button press */
                 Cy_SysLib_Delay(250);
                 break;
 
             case SWITCH_LONG_PRESS:
-                /* Go to deep sleep */
-                Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+                LogStackHighWater();
+
+                deepSleep = PmQos_IsDeepSleepAllowed();
+                if (deepSleep)
+                {
+                    /* Go to deep sleep */
+                    TelemetryLog_SetMode(TELEMETRY_MODE_DEEP_SLEEP);
+                    deepSleep = (CY_SYSPM_SUCCESS == Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT));
+                    FastWake_Resumed();
+                }
+                if (!deepSleep)
+                {
+                    /* A latency constraint or a QSPI erase rules out deep
+                     * sleep, only sleep */
+                    TelemetryLog_SetMode(Cy_SysPm_IsSystemUlp() ? TELEMETRY_MODE_ULP_SLEEP : TELEMETRY_MODE_LP_SLEEP);
+                    Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+                }
+                TelemetryLog_SetMode(GetActiveMode());
                 /* Wait a bit to avoid glitches in the button press */
                 Cy_SysLib_Delay(250);
                 break;
@@ -221,6 +406,24 @@ int main(void)
             default:
                 break;
         }
+
+        /* Swap between System LP and ULP, again while it is refused */
+        if (systemModeSwitchPending)
+        {
+            systemModeSwitchPending = !SwitchSystemMode();
+        }
+
+        /* Raise the clock once the FLL has locked after a wake-up */
+        FastWake_Process();
+
+        /* Move clk_lf to the WCO once it is stable (never blocks) */
+        LfClock_Process();
+
+        /* Write buffered telemetry to the QSPI memory (never blocks) */
+        TelemetryLog_Process();
+
+        /* Suspend the peripherals that have been idle for long enough */
+        RuntimePm_Process();
     }
 }
 
@@ -236,7 +439,7 @@ int main(void)
 *******************************************************************************/
 SwitchEvent GetSwitchEvent(void)
 {
-    unsigned int pressCount;
+    uint32_t pressCount;
     SwitchEvent event = SWITCH_NO_EVENT;
 
     /* Check if KIT_BTN1 is pressed */
@@ -247,33 +450,17 @@ SwitchEvent GetSwitchEvent(void)
                    CY_TCPWM_COUNTER_STATUS_COUNTER_RUNNING))
         {
             /* Enable and trigger the counter */
-            Cy_TCPWM_Counter_SetCounter(APP_COUNTER_HW, APP_COUNTER_NUM, 0u);
-            Cy_TCPWM_Counter_Enable(APP_COUNTER_HW, APP_COUNTER_NUM);
-            Cy_TCPWM_TriggerStart(APP_COUNTER_HW, APP_COUNTER_MASK);
+            StartSwitchCounter();
         }
     }
     else
     {
         /* If button not pressed, check the counter value */
         pressCount = Cy_TCPWM_Counter_GetCounter(APP_COUNTER_HW, APP_COUNTER_NUM);
-
-        /* Check if KIT_BTN1 was pressed for a long time */
-        if (pressCount > LONG_PRESS_COUNT)
-        {
-            event = SWITCH_LONG_PRESS;
-        }
-        /* Check if KIT_BTN1 was pressed for a short time */
-        else if (pressCount > SHORT_PRESS_COUNT)
-        {
-            event = SWITCH_SHORT_PRESS;
-        }
-        else if (pressCount > QUICK_PRESS_COUNT)
-        {
-            event = SWITCH_QUICK_PRESS;
-        }
+        event = ClassifySwitchPress(pressCount);
 
         /* Disable the switch counter */
-        Cy_TCPWM_Counter_Disable(APP_COUNTER_HW, APP_COUNTER_NUM);
+        StopSwitchCounter();
 
         /* Reset the switch counter */
         Cy_TCPWM_Counter_SetCounter(APP_COUNTER_HW, APP_COUNTER_NUM, 0u);
@@ -285,6 +472,137 @@ SwitchEvent GetSwitchEvent(void)
     return event;
 }
 
+/*******************************************************************************
+* Function Name: ClassifySwitchPress
+****************************************************************************//**
+*
+* Returns the event for a press of KIT_BTN1 that lasted pressCount counts of
+* the switch counter.
+*
+*******************************************************************************/
+APP_HOT SwitchEvent ClassifySwitchPress(uint32_t pressCount)
+{
+    SwitchEvent event = SWITCH_NO_EVENT;
+
+    /* Check if KIT_BTN1 was pressed for a long time */
+    if (pressCount > LONG_PRESS_COUNT)
+    {
+        event = SWITCH_LONG_PRESS;
+    }
+    /* Check if KIT_BTN1 was pressed for a short time */
+    else if (pressCount > SHORT_PRESS_COUNT)
+    {
+        event = SWITCH_SHORT_PRESS;
+    }
+    else if (pressCount > QUICK_PRESS_COUNT)
+    {
+        event = SWITCH_QUICK_PRESS;
+    }
+
+    return event;
+}
+
+/*******************************************************************************
+* Function Name: StartSwitchCounter
+****************************************************************************//**
+*
+* Resumes the switch counter if needed, then starts counting from 0.
+*
+*******************************************************************************/
+void StartSwitchCounter(void)
+{
+    if (!switchCounterHeld)
+    {
+        RuntimePm_Get(RUNTIME_PM_DEV_COUNTER);
+        switchCounterHeld = true;
+    }
+
+    Cy_TCPWM_Counter_SetCounter(APP_COUNTER_HW, APP_COUNTER_NUM, 0u);
+    Cy_TCPWM_TriggerStart(APP_COUNTER_HW, APP_COUNTER_MASK);
+}
+
+/*******************************************************************************
+* Function Name: StopSwitchCounter
+****************************************************************************//**
+*
+* Stops the switch counter. The count can still be read. The counter is
+* disabled and unclocked once it has been idle for RUNTIME_PM_COUNTER_DELAY_MS.
+*
+*******************************************************************************/
+APP_HOT void StopSwitchCounter(void)
+{
+    Cy_TCPWM_TriggerStopOrKill(APP_COUNTER_HW, APP_COUNTER_MASK);
+
+    if (switchCounterHeld)
+    {
+        RuntimePm_Put(RUNTIME_PM_DEV_COUNTER);
+        switchCounterHeld = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: SwitchSystemMode
+****************************************************************************//**
+*
+* Swaps from System LP to ULP (vice-versa) and records the transition. Returns
+* false if a callback refused it, for example while the QSPI memory is erasing
+* a sector; the System mode is then unchanged.
+*
+*******************************************************************************/
+bool SwitchSystemMode(void)
+{
+    cy_en_syspm_status_t status;
+
+    /* Check if the device is in System ULP mode */
+    if (Cy_SysPm_IsSystemUlp())
+    {
+        /* Switch to System LP mode */
+        status = Cy_SysPm_SystemEnterLp();
+    }
+    else
+    {
+        /* Switch to ULP mode */
+        status = Cy_SysPm_SystemEnterUlp();
+    }
+
+    if (CY_SYSPM_SUCCESS != status)
+    {
+        return false;
+    }
+
+    TelemetryLog_SetMode(GetActiveMode());
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: GetActiveMode
+****************************************************************************//**
+*
+* Returns the telemetry mode that matches the current System power mode while
+* the CPU is active.
+*
+*******************************************************************************/
+TelemetryMode GetActiveMode(void)
+{
+    return Cy_SysPm_IsSystemUlp() ? TELEMETRY_MODE_ULP_ACTIVE : TELEMETRY_MODE_LP_ACTIVE;
+}
+
+/*******************************************************************************
+* Function Name: LogStackHighWater
+****************************************************************************//**
+*
+* Samples the stack high-water mark of the CM4, reads the one published by the
+* CM0+, and logs those that have grown. Called before the CPU sleeps, where
+* the scan does not delay the button timing.
+*
+*******************************************************************************/
+void LogStackHighWater(void)
+{
+    TelemetryLog_SetStackHighWater(TELEMETRY_CORE_CM4, StackWatch_Sample());
+    TelemetryLog_SetStackHighWater(TELEMETRY_CORE_CM0P, StackWatch_GetPublished());
+}
+
 /*******************************************************************************
 * Function Name: TCPWM_SleepCallback
 ****************************************************************************//**
@@ -293,10 +611,11 @@ SwitchEvent GetSwitchEvent(void)
 * System Mode.
 * - LP Mode CPU Sleep  : LED is turned ON
 * - ULP Mode CPU Sleep : LED is dimmed.
-* Note that the LED brightness is controlled using the PWM block.
+* Note that the LED brightness is controlled using the PWM block. The blink
+* pattern of the System Mode is saved before and restored after.
 *
 *******************************************************************************/
-cy_en_syspm_status_t TCPWM_SleepCallback(
+APP_HOT cy_en_syspm_status_t TCPWM_SleepCallback(
     cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
 {
     cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
@@ -304,6 +623,8 @@ cy_en_syspm_status_t TCPWM_SleepCallback(
     switch (mode)
     {
         case CY_SYSPM_BEFORE_TRANSITION:
+            /* Save the blink pattern */
+            RegContext_Save(&ledPwmContext);
 
             /* Check if the device is in System ULP mode */
             if (Cy_SysPm_IsSystemUlp())
@@ -318,24 +639,15 @@ cy_en_syspm_status_t TCPWM_SleepCallback(
             }
 
             /* Disable switch Counter */
-            Cy_TCPWM_Counter_Disable(APP_COUNTER_HW, APP_COUNTER_NUM);
+            StopSwitchCounter();
+            (void)RuntimePm_Suspend(RUNTIME_PM_DEV_COUNTER);
 
             retVal = CY_SYSPM_SUCCESS;
             break;
 
         case CY_SYSPM_AFTER_TRANSITION:
-
-            /* Check if the device is in System ULP mode */
-            if (Cy_SysPm_IsSystemUlp())
-            {
-                /* After waking up, set the slow blink pattern */
-                PWM_LED_ACTION(LED_BLINK_SLOW);
-            }
-            else
-            {
-                /* After waking up, set the fast blink pattern */
-                PWM_LED_ACTION(LED_BLINK_FAST);
-            }
+            /* After waking up, restore the blink pattern */
+            RegContext_Restore(&ledPwmContext);
 
             retVal = CY_SYSPM_SUCCESS;
             break;
@@ -353,13 +665,16 @@ cy_en_syspm_status_t TCPWM_SleepCallback(
 * Function Name: TCPWM_DeepSleepCallback
 ****************************************************************************//**
 *
-* Deep Sleep callback implementation. It turns the LED off before going to deep
-* sleep power mode. After waking up, it sets the LED to blink.
-* Note that the PWM block needs to be re-enabled after waking up, since the
-* clock feeding the PWM is disabled in deep sleep.
+* Deep Sleep callback implementation. It turns the PWM off before going to deep
+* sleep power mode and hands the LED over to the LF-timed alive indicator,
+* which pulses it briefly every couple of seconds. After waking up, it restores
+* the blink pattern saved before.
+* Note that the PWM registers are retained in deep sleep. The callback writes
+* back the snapshot of ledPwmContext, which brings back the blink phase, and
+* restarts the PWM that it stopped itself.
 *
 *******************************************************************************/
-cy_en_syspm_status_t TCPWM_DeepSleepCallback(
+APP_HOT cy_en_syspm_status_t TCPWM_DeepSleepCallback(
     cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
 {
     cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
@@ -368,30 +683,29 @@ cy_en_syspm_status_t TCPWM_DeepSleepCallback(
     {
         case CY_SYSPM_BEFORE_TRANSITION:
             /* Before going to sleep mode, turn off the LEDs */
-            Cy_TCPWM_PWM_Disable(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM);
+            RuntimePm_Put(RUNTIME_PM_DEV_LED_PWM);
+            (void)RuntimePm_Suspend(RUNTIME_PM_DEV_LED_PWM);
+
+            /* Save the blink pattern of the stopped PWM */
+            RegContext_Save(&ledPwmContext);
 
             /* Disable the switch counter */
-            Cy_TCPWM_Counter_Disable(APP_COUNTER_HW, APP_COUNTER_NUM);
+            StopSwitchCounter();
+            (void)RuntimePm_Suspend(RUNTIME_PM_DEV_COUNTER);
+
+            /* Keep signaling "alive" from the LF domain */
+            AliveLed_Start();
 
             retVal = CY_SYSPM_SUCCESS;
             break;
 
         case CY_SYSPM_AFTER_TRANSITION:
-            /* Re-enable PWM */
-            Cy_TCPWM_PWM_Enable(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM);
-            Cy_TCPWM_TriggerStart(KIT_LED1_PWM_HW, KIT_LED1_PWM_MASK);
+            /* Take the LED back from the alive indicator */
+            AliveLed_Stop();
 
-            /* Check if the device is in System ULP mode */
-            if (Cy_SysPm_IsSystemUlp())
-            {
-                /* After waking up, set the slow blink pattern */
-                PWM_LED_ACTION(LED_BLINK_SLOW);
-            }
-            else
-            {
-                /* After waking up, set the fast blink pattern */
-                PWM_LED_ACTION(LED_BLINK_FAST);
-            }
+            /* Restore the blink pattern and re-enable PWM */
+            RegContext_Restore(&ledPwmContext);
+            RuntimePm_Get(RUNTIME_PM_DEV_LED_PWM);
 
             retVal = CY_SYSPM_SUCCESS;
             break;
@@ -413,7 +727,7 @@ cy_en_syspm_status_t TCPWM_DeepSleepCallback(
 * pattern.
 *
 *******************************************************************************/
-cy_en_syspm_status_t TCPWM_EnterUltraLowPowerCallback(
+APP_HOT cy_en_syspm_status_t TCPWM_EnterUltraLowPowerCallback(
         cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
 {
     cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
@@ -444,7 +758,7 @@ cy_en_syspm_status_t TCPWM_EnterUltraLowPowerCallback(
 * pattern.
 *
 *******************************************************************************/
-cy_en_syspm_status_t TCPWM_ExitUltraLowPowerCallback(
+APP_HOT cy_en_syspm_status_t TCPWM_ExitUltraLowPowerCallback(
         cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
 {
     cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
@@ -475,7 +789,7 @@ cy_en_syspm_status_t TCPWM_ExitUltraLowPowerCallback(
 * half.
 *
 *******************************************************************************/
-cy_en_syspm_status_t Clock_EnterUltraLowPowerCallback(
+APP_HOT cy_en_syspm_status_t Clock_EnterUltraLowPowerCallback(
         cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
 {
     cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
@@ -515,7 +829,7 @@ cy_en_syspm_status_t Clock_EnterUltraLowPowerCallback(
 * frequency for the device.
 *
 *******************************************************************************/
-cy_en_syspm_status_t Clock_ExitUltraLowPowerCallback(
+APP_HOT cy_en_syspm_status_t Clock_ExitUltraLowPowerCallback(
         cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
 {
     cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
@@ -554,7 +868,7 @@ cy_en_syspm_status_t Clock_ExitUltraLowPowerCallback(
 * Wake-up pin interrupt handler. Clear the interrupt only.
 *
 *******************************************************************************/
-void WakeupInterruptHandler(void)
+APP_HOT void WakeupInterruptHandler(void)
 {
     /* Clear any pending interrupt */
     if (0u != Cy_GPIO_GetInterruptStatusMasked(KIT_BTN1_PORT, KIT_BTN1_NUM))
@@ -0,0 +1,31 @@
+/***************************************************************************//**
+* \file no_hal.h
+* \version 1.0
+*
+* \brief
+* Removes the HAL from a build that does not link it.
+*
+* The BSP adds CY_USING_HAL to DEFINES, which makes the generated code reserve
+* the resources it configures with the HAL resource manager. Lean builds
+* (LEAN_BUILD=1) leave out the HAL, and the Makefile then passes this header to
+* the compiler as a forced include. The compiler processes forced includes after
+* all the -D and -U options of the command line, so the #undef below applies to
+* every source file, wherever the build system places -DCY_USING_HAL in the
+* compile line.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(NO_HAL_H)
+#define NO_HAL_H
+
+#undef CY_USING_HAL
+
+#endif /* NO_HAL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,156 @@
+/***************************************************************************//**
+* \file pin_park.c
+* \version 1.0
+*
+* \brief
+* Parking of the unused I/O in System Deep Sleep. See pin_park.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "app_sections.h"
+#include "pin_park.h"
+#include "reg_context.h"
+
+
+#if defined(PIN_PARK)
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Pins parked in System Deep Sleep */
+static const PinParkPin pinParkPins[] =
+{
+    { CYBSP_CSD_TX_PORT, CYBSP_CSD_TX_PIN },
+    { ioss_0_port_6_pin_0_PORT, ioss_0_port_6_pin_0_PIN },
+    { ioss_0_port_6_pin_1_PORT, ioss_0_port_6_pin_1_PIN },
+    { CYBSP_CINA_PORT, CYBSP_CINA_PIN },
+    { CYBSP_CINB_PORT, CYBSP_CINB_PIN },
+    { CYBSP_CMOD_PORT, CYBSP_CMOD_PIN },
+    { CYBSP_CSD_BTN0_PORT, CYBSP_CSD_BTN0_PIN },
+    { CYBSP_CSD_BTN1_PORT, CYBSP_CSD_BTN1_PIN },
+    { CYBSP_CSD_SLD0_PORT, CYBSP_CSD_SLD0_PIN },
+    { CYBSP_CSD_SLD1_PORT, CYBSP_CSD_SLD1_PIN },
+    { CYBSP_CSD_SLD2_PORT, CYBSP_CSD_SLD2_PIN },
+    { CYBSP_CSD_SLD3_PORT, CYBSP_CSD_SLD3_PIN },
+    { CYBSP_CSD_SLD4_PORT, CYBSP_CSD_SLD4_PIN },
+};
+
+/* AMUX bus splits closed by init_cycfg_routing() */
+#define PIN_PARK_SPLIT_A    2u
+#define PIN_PARK_SPLIT_B    4u
+
+/* Configuration of the ports of the parked pins (1, 6, 7 and 8) and of the
+ * splits. The drive modes go back first, then the AMUX connections. */
+static const RegContextRange pinParkContextRanges[] =
+{
+    { &GPIO_PRT1->CFG, 1u },
+    { &GPIO_PRT6->CFG, 1u },
+    { &GPIO_PRT7->CFG, 1u },
+    { &GPIO_PRT8->CFG, 1u },
+    { &HSIOM_PRT1->PORT_SEL0, 2u },
+    { &HSIOM_PRT6->PORT_SEL0, 2u },
+    { &HSIOM_PRT7->PORT_SEL0, 2u },
+    { &HSIOM_PRT8->PORT_SEL0, 2u },
+    { &HSIOM->AMUX_SPLIT_CTL[PIN_PARK_SPLIT_A], 1u },
+    { &HSIOM->AMUX_SPLIT_CTL[PIN_PARK_SPLIT_B], 1u },
+};
+
+/* Words of the context: 4 CFG, 4 x 2 PORT_SEL, 2 AMUX_SPLIT_CTL */
+#define PIN_PARK_CONTEXT_WORDS  14u
+
+/* SysPm callbacks */
+static const SysPmRegistryEntry pinParkSysPmEntries[] =
+{
+    { PinPark_DeepSleepCallback, CY_SYSPM_DEEPSLEEP,
+      SYSPM_PHASE_BEFORE_TRANSITION | SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_PERIPHERAL },
+};
+
+const SysPmRegistryTable pinParkSysPmTable =
+{
+    pinParkSysPmEntries, sizeof(pinParkSysPmEntries) / sizeof(pinParkSysPmEntries[0])
+};
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t pinParkSnapshot[PIN_PARK_CONTEXT_WORDS];
+
+static const RegContext pinParkContext =
+{
+    pinParkContextRanges, sizeof(pinParkContextRanges) / sizeof(pinParkContextRanges[0]), pinParkSnapshot
+};
+
+
+/*******************************************************************************
+* Function Name: PinPark_Init
+****************************************************************************//**
+*
+* Drives WL_REG_ON low, which keeps the Wi-Fi chip powered down.
+*
+*******************************************************************************/
+void PinPark_Init(void)
+{
+    Cy_GPIO_Pin_FastInit(PIN_PARK_WL_REG_ON_PORT, PIN_PARK_WL_REG_ON_PIN,
+                         CY_GPIO_DM_STRONG_IN_OFF, 0u, HSIOM_SEL_GPIO);
+}
+
+/*******************************************************************************
+* Function Name: PinPark_DeepSleepCallback
+****************************************************************************//**
+*
+* Deep Sleep callback implementation. Before the transition it saves the port
+* configuration, disconnects the parked pins from the AMUX buses, sets them to
+* analog high-Z and opens the AMUX splits. After the transition it restores
+* the configuration.
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t PinPark_DeepSleepCallback(
+    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+    uint32_t pin;
+
+    switch (mode)
+    {
+        case CY_SYSPM_BEFORE_TRANSITION:
+            RegContext_Save(&pinParkContext);
+
+            for (pin = 0u; pin < (sizeof(pinParkPins) / sizeof(pinParkPins[0])); pin++)
+            {
+                Cy_GPIO_SetHSIOM(pinParkPins[pin].port, pinParkPins[pin].pin, HSIOM_SEL_GPIO);
+                Cy_GPIO_SetDrivemode(pinParkPins[pin].port, pinParkPins[pin].pin, CY_GPIO_DM_ANALOG);
+            }
+
+            HSIOM->AMUX_SPLIT_CTL[PIN_PARK_SPLIT_A] = 0u;
+            HSIOM->AMUX_SPLIT_CTL[PIN_PARK_SPLIT_B] = 0u;
+
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            RegContext_Restore(&pinParkContext);
+
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+#endif /* defined(PIN_PARK) */
+
+/* [] END OF FILE */
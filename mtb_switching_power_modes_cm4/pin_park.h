@@ -0,0 +1,78 @@
+/***************************************************************************//**
+* \file pin_park.h
+* \version 1.0
+*
+* \brief
+* Parking of the unused I/O in System Deep Sleep.
+*
+* The pins that nothing needs in System Deep Sleep are listed in a table:
+* the CapSense pins (CSD0 is never started), and P6[0] and P6[1] to the
+* KitProg. Before Deep Sleep their port configuration is saved (see
+* reg_context.h), they are switched to analog high-Z on the GPIO, and the
+* AMUX bus splits are opened. After wake-up one restore pass brings the drive
+* modes, the AMUX connections and the splits back.
+*
+* Pins that stay as configured: KIT_BTN1 (the wake-up source), KIT_LED1 (the
+* alive indicator), the WCO pins, and the SWD pins, so that a debugger can
+* still attach (production builds release them at startup, see debug_port.h).
+*
+* The CYW4343W Wi-Fi chip is not used. PinPark_Init() drives its WL_REG_ON
+* pin low, which holds the chip in its lowest power state, instead of leaving
+* it floating. The SDIO pins stay in their reset state (analog high-Z).
+*
+* The module is only built with PIN_PARK=1 (the default), so that the Deep
+* Sleep current can be compared with PIN_PARK=0.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PIN_PARK_H)
+#define PIN_PARK_H
+
+#include "cy_pdl.h"
+#include "syspm_registry.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* WL_REG_ON of the CYW4343W (CYBSP_WIFI_WL_REG_ON) */
+#define PIN_PARK_WL_REG_ON_PORT     GPIO_PRT2
+#define PIN_PARK_WL_REG_ON_PIN      6u
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    GPIO_PRT_Type *port;
+    uint32_t pin;
+} PinParkPin;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const SysPmRegistryTable pinParkSysPmTable;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void PinPark_Init(void);
+
+cy_en_syspm_status_t PinPark_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PIN_PARK_H */
+
+/* [] END OF FILE */
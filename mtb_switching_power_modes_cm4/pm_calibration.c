@@ -0,0 +1,381 @@
+/***************************************************************************//**
+* \file pm_calibration.c
+* \version 1.0
+*
+* \brief
+* Calibration of the power mode transition costs. See pm_calibration.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if defined(PM_CALIBRATION)
+
+#include <string.h>
+#include "cy_pdl.h"
+#include "fast_wake.h"
+#include "pm_qos.h"
+#include "runtime_pm.h"
+#include "smif_mem.h"
+#include "time_base.h"
+#include "telemetry_format.h"
+#include "pm_calibration.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Time to wait for the MCWDT to synchronize with clk_lf (in microseconds) */
+#define PM_CALIBRATION_SYNC_US      93u
+
+/* MCWDT counter 0 is 16 bits wide */
+#define PM_CALIBRATION_COUNT_MASK   0xFFFFu
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static PmCalibrationCost pmCalibrationTable[PM_CALIBRATION_COUNT];
+static uint32_t pmCalibrationValid = 0u;    /* Bit per measured transition */
+
+/* Page written to the QSPI memory, it must stay unchanged while programming */
+static uint8_t pmCalibrationPage[TELEMETRY_PAGE_SIZE];
+
+
+/*******************************************************************************
+* Function Name: PmCalibration_WaitTick
+****************************************************************************//**
+*
+* Waits for the next clk_lf tick and returns the time base at that tick, so
+* that a measurement starts on a tick boundary.
+*
+*******************************************************************************/
+static uint64_t PmCalibration_WaitTick(void)
+{
+    uint64_t start = TimeBase_GetTicks();
+    uint64_t now;
+
+    do
+    {
+        now = TimeBase_GetTicks();
+    }
+    while (now == start);
+
+    return now;
+}
+
+/*******************************************************************************
+* Function Name: PmCalibration_Measure
+****************************************************************************//**
+*
+* Runs a transition once. Returns the time base ticks it cost, or UINT32_MAX
+* if it was refused by a callback.
+*
+*******************************************************************************/
+static uint32_t PmCalibration_Measure(PmCalibrationTransition transition)
+{
+    cy_en_syspm_status_t status;
+    uint32_t match;
+    uint32_t sleepTicks = 0u;
+    uint64_t start;
+    uint64_t end;
+
+    if ((PM_CALIBRATION_SLEEP == transition) || (PM_CALIBRATION_DEEP_SLEEP == transition))
+    {
+        /* Wake up on a match PM_CALIBRATION_SLEEP_TICKS from now */
+        match = (Cy_MCWDT_GetCount(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_COUNTER) +
+                 PM_CALIBRATION_SLEEP_TICKS) & PM_CALIBRATION_COUNT_MASK;
+        Cy_MCWDT_SetMatch(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_COUNTER, match, PM_CALIBRATION_SYNC_US);
+        Cy_MCWDT_ClearInterrupt(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_MASK);
+
+        start = PmCalibration_WaitTick();
+        sleepTicks = (match - Cy_MCWDT_GetCount(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_COUNTER)) &
+                     PM_CALIBRATION_COUNT_MASK;
+
+        /* MCWDT counts are at the clk_lf rate, 32000 Hz if the WCO failed */
+        sleepTicks = (uint32_t)(((uint64_t)sleepTicks * TIME_BASE_TICKS_PER_SEC) / TimeBase_GetClockHz());
+    }
+    else
+    {
+        start = PmCalibration_WaitTick();
+    }
+
+    switch (transition)
+    {
+        case PM_CALIBRATION_LP_TO_ULP:
+            status = Cy_SysPm_SystemEnterUlp();
+            break;
+
+        case PM_CALIBRATION_ULP_TO_LP:
+            status = Cy_SysPm_SystemEnterLp();
+            break;
+
+        case PM_CALIBRATION_SLEEP:
+            status = Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+            break;
+
+        default:
+            status = Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+            break;
+    }
+
+    end = TimeBase_GetTicks();
+
+    if (PM_CALIBRATION_DEEP_SLEEP == transition)
+    {
+        /* Back to full speed before the next run */
+        (void)FastWake_Finish();
+    }
+
+    if (CY_SYSPM_SUCCESS != status)
+    {
+        return UINT32_MAX;
+    }
+
+    end -= start;
+    return (end > sleepTicks) ? (uint32_t)(end - sleepTicks) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: PmCalibration_Load
+****************************************************************************//**
+*
+* Reads the table from the QSPI memory. Returns false if it is missing or
+* damaged.
+*
+*******************************************************************************/
+static bool PmCalibration_Load(void)
+{
+    const uint8_t *record;
+    bool valid;
+    uint32_t i;
+
+    RuntimePm_Get(RUNTIME_PM_DEV_SMIF);
+
+    record = SmifMem_GetMappedAddress(PM_CALIBRATION_OFFSET);
+    valid = (PM_CALIBRATION_MAGIC == TelemetryFormat_GetU32(&record[0])) &&
+            (PM_CALIBRATION_COUNT == TelemetryFormat_GetU32(&record[4])) &&
+            (TelemetryFormat_Crc32(0u, record, PM_CALIBRATION_RECORD_SIZE - 4u) ==
+             TelemetryFormat_GetU32(&record[PM_CALIBRATION_RECORD_SIZE - 4u]));
+
+    if (valid)
+    {
+        for (i = 0u; i < PM_CALIBRATION_COUNT; i++)
+        {
+            pmCalibrationTable[i].costUs = TelemetryFormat_GetU32(&record[8u + (8u * i)]);
+            pmCalibrationTable[i].maxCostUs = TelemetryFormat_GetU32(&record[12u + (8u * i)]);
+        }
+        pmCalibrationValid = (1UL << PM_CALIBRATION_COUNT) - 1u;
+    }
+
+    RuntimePm_Put(RUNTIME_PM_DEV_SMIF);
+
+    return valid;
+}
+
+/*******************************************************************************
+* Function Name: PmCalibration_Init
+****************************************************************************//**
+*
+* Loads the table from the QSPI memory, or calibrates and saves it if there is
+* none. Then hands the Deep Sleep cost to PM QoS. Call after the SysPm
+* callbacks are registered and before the telemetry log is written. It enters
+* System ULP and Deep Sleep and writes the QSPI memory, so it cannot be cold
+* code. Returns false if a new table could not be saved.
+*
+*******************************************************************************/
+bool PmCalibration_Init(void)
+{
+    bool valid = PmCalibration_Load();
+
+    if (!valid)
+    {
+        valid = PmCalibration_Run() && PmCalibration_Save();
+    }
+    else
+    {
+        PmQos_SetDeepSleepLatency(pmCalibrationTable[PM_CALIBRATION_DEEP_SLEEP].maxCostUs);
+    }
+
+    return valid;
+}
+
+/*******************************************************************************
+* Function Name: PmCalibration_Run
+****************************************************************************//**
+*
+* Measures every transition PM_CALIBRATION_RUNS times and updates the table
+* and the PM QoS Deep Sleep latency. The device is left in the System power
+* mode it was in. Takes a few tens of milliseconds; the LED patterns change
+* as the callbacks run. Returns false if every run of a transition was
+* refused; that transition keeps its previous cost.
+*
+*******************************************************************************/
+bool PmCalibration_Run(void)
+{
+    bool ulp = Cy_SysPm_IsSystemUlp();
+    uint32_t mask = Cy_MCWDT_GetInterruptMask(PM_CALIBRATION_MCWDT_HW);
+    uint32_t transition;
+    uint32_t run;
+    uint32_t ticks;
+    uint32_t sum;
+    uint32_t valid;
+    uint32_t worst;
+    bool complete = true;
+
+    if (ulp)
+    {
+        (void)Cy_SysPm_SystemEnterLp();
+    }
+
+    /* Free-running wake-up counter next to the time base counter */
+    Cy_MCWDT_SetMode(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_COUNTER, CY_MCWDT_MODE_INT);
+    Cy_MCWDT_SetClearOnMatch(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_COUNTER, 0u);
+    Cy_MCWDT_Enable(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_MASK, PM_CALIBRATION_SYNC_US);
+    Cy_MCWDT_SetInterruptMask(PM_CALIBRATION_MCWDT_HW, mask | PM_CALIBRATION_MCWDT_MASK);
+
+    for (transition = 0u; transition < (uint32_t)PM_CALIBRATION_COUNT; transition++)
+    {
+        sum = 0u;
+        valid = 0u;
+        worst = 0u;
+
+        for (run = 0u; run < PM_CALIBRATION_RUNS; run++)
+        {
+            /* The System mode transitions are measured in pairs */
+            if (PM_CALIBRATION_ULP_TO_LP == transition)
+            {
+                (void)Cy_SysPm_SystemEnterUlp();
+            }
+
+            ticks = PmCalibration_Measure((PmCalibrationTransition)transition);
+
+            if (PM_CALIBRATION_LP_TO_ULP == transition)
+            {
+                (void)Cy_SysPm_SystemEnterLp();
+            }
+
+            if (UINT32_MAX != ticks)
+            {
+                sum += ticks;
+                valid++;
+                worst = (ticks > worst) ? ticks : worst;
+            }
+        }
+
+        if (0u != valid)
+        {
+            pmCalibrationTable[transition].costUs = TIME_BASE_TICKS_TO_US(sum / valid);
+            pmCalibrationTable[transition].maxCostUs = TIME_BASE_TICKS_TO_US(worst);
+            pmCalibrationValid |= 1UL << transition;
+        }
+        else
+        {
+            complete = false;
+        }
+    }
+
+    Cy_MCWDT_SetInterruptMask(PM_CALIBRATION_MCWDT_HW, mask);
+    Cy_MCWDT_Disable(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_MASK, PM_CALIBRATION_SYNC_US);
+    Cy_MCWDT_ClearInterrupt(PM_CALIBRATION_MCWDT_HW, PM_CALIBRATION_MCWDT_MASK);
+
+    if (ulp)
+    {
+        (void)Cy_SysPm_SystemEnterUlp();
+    }
+
+    if (0u != (pmCalibrationValid & (1UL << PM_CALIBRATION_DEEP_SLEEP)))
+    {
+        PmQos_SetDeepSleepLatency(pmCalibrationTable[PM_CALIBRATION_DEEP_SLEEP].maxCostUs);
+    }
+
+    return complete;
+}
+
+/*******************************************************************************
+* Function Name: PmCalibration_Save
+****************************************************************************//**
+*
+* Writes the table to the reserved QSPI sector and waits for the erase and
+* program to complete. Must be called in System LP with no telemetry page
+* being written. Returns false, without writing, if a transition has never
+* been measured, so that the calibration runs again at the next boot, or if
+* the memory reported an error.
+*
+*******************************************************************************/
+bool PmCalibration_Save(void)
+{
+    bool saved = false;
+    uint32_t i;
+
+    if (((1UL << PM_CALIBRATION_COUNT) - 1u) != pmCalibrationValid)
+    {
+        return false;
+    }
+
+    memset(pmCalibrationPage, 0xFF, sizeof(pmCalibrationPage));
+    TelemetryFormat_PutU32(&pmCalibrationPage[0], PM_CALIBRATION_MAGIC);
+    TelemetryFormat_PutU32(&pmCalibrationPage[4], PM_CALIBRATION_COUNT);
+    for (i = 0u; i < PM_CALIBRATION_COUNT; i++)
+    {
+        TelemetryFormat_PutU32(&pmCalibrationPage[8u + (8u * i)], pmCalibrationTable[i].costUs);
+        TelemetryFormat_PutU32(&pmCalibrationPage[12u + (8u * i)], pmCalibrationTable[i].maxCostUs);
+    }
+    TelemetryFormat_PutU32(&pmCalibrationPage[PM_CALIBRATION_RECORD_SIZE - 4u],
+                           TelemetryFormat_Crc32(0u, pmCalibrationPage, PM_CALIBRATION_RECORD_SIZE - 4u));
+
+    RuntimePm_Get(RUNTIME_PM_DEV_SMIF);
+
+    if (CY_SMIF_SUCCESS == SmifMem_EraseSector(PM_CALIBRATION_OFFSET))
+    {
+        for (i = 0u; SmifMem_IsBusy() && (i < SMIF_MEM_ERASE_TIME_MS); i++)
+        {
+            Cy_SysLib_Delay(1u);
+        }
+
+        if (!SmifMem_IsBusy() && (CY_SMIF_SUCCESS == SmifMem_ProgramPage(PM_CALIBRATION_OFFSET, pmCalibrationPage)))
+        {
+            for (i = 0u; SmifMem_IsBusy() && (i < SMIF_MEM_PROGRAM_TIME_US); i++)
+            {
+                Cy_SysLib_DelayUs(1u);
+            }
+            saved = !SmifMem_IsBusy();
+        }
+    }
+
+    RuntimePm_Put(RUNTIME_PM_DEV_SMIF);
+
+    return saved;
+}
+
+/*******************************************************************************
+* Function Name: PmCalibration_GetCost
+****************************************************************************//**
+*
+* Returns the mean cost of a transition in microseconds, 0 if unknown.
+*
+*******************************************************************************/
+uint32_t PmCalibration_GetCost(PmCalibrationTransition transition)
+{
+    return pmCalibrationTable[transition].costUs;
+}
+
+/*******************************************************************************
+* Function Name: PmCalibration_GetMaxCost
+****************************************************************************//**
+*
+* Returns the worst-case cost of a transition in microseconds, 0 if unknown.
+*
+*******************************************************************************/
+uint32_t PmCalibration_GetMaxCost(PmCalibrationTransition transition)
+{
+    return pmCalibrationTable[transition].maxCostUs;
+}
+
+#endif /* defined(PM_CALIBRATION) */
+
+/* [] END OF FILE */
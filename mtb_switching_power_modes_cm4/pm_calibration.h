@@ -0,0 +1,94 @@
+/***************************************************************************//**
+* \file pm_calibration.h
+* \version 1.0
+*
+* \brief
+* Calibration of the power mode transition costs.
+*
+* Each transition is exercised PM_CALIBRATION_RUNS times with all the SysPm
+* callbacks registered, and timed with the LF time base (clk_lf, 30.5 us
+* resolution). The sleep modes are woken up by a match of MCWDT1 counter 0
+* after a known number of ticks; their cost is the time spent on top of it.
+* The cost of System LP <-> ULP is the duration of the call.
+*
+* The table is kept in a reserved sector of the QSPI memory, just below the
+* telemetry log, with a CRC-32, so the calibration only runs when the table is
+* missing or on demand. The worst-case Deep Sleep cost becomes the Deep Sleep
+* wake-up latency used by PM QoS.
+*
+* The module is only built with PM_CALIBRATION=1.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PM_CALIBRATION_H)
+#define PM_CALIBRATION_H
+
+#include "cy_pdl.h"
+#include "telemetry_format.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+typedef enum
+{
+    PM_CALIBRATION_LP_TO_ULP    = 0u,   /* Cy_SysPm_SystemEnterUlp() */
+    PM_CALIBRATION_ULP_TO_LP    = 1u,   /* Cy_SysPm_SystemEnterLp() */
+    PM_CALIBRATION_SLEEP        = 2u,   /* CPU Sleep, entry and exit */
+    PM_CALIBRATION_DEEP_SLEEP   = 3u,   /* System Deep Sleep, entry and exit */
+    PM_CALIBRATION_COUNT        = 4u,
+} PmCalibrationTransition;
+
+/* Runs per transition */
+#define PM_CALIBRATION_RUNS         4u
+
+/* Sleep time of the sleep mode runs (in clk_lf ticks, ~1 ms) */
+#define PM_CALIBRATION_SLEEP_TICKS  33u
+
+/* Wake-up timer: counter 0 of the time base MCWDT */
+#define PM_CALIBRATION_MCWDT_HW         MCWDT_STRUCT1
+#define PM_CALIBRATION_MCWDT_COUNTER    CY_MCWDT_COUNTER0
+#define PM_CALIBRATION_MCWDT_MASK       CY_MCWDT_CTR0
+
+/* Reserved QSPI sector, just below the telemetry log */
+#define PM_CALIBRATION_OFFSET       (TELEMETRY_LOG_OFFSET - TELEMETRY_SECTOR_SIZE)
+
+/* Stored table: magic (4), count (4), cost and maximum cost per transition
+ * (8 each), CRC-32 (4) */
+#define PM_CALIBRATION_MAGIC        0x4C414350u     /* "PCAL" */
+#define PM_CALIBRATION_RECORD_SIZE  (12u + (8u * PM_CALIBRATION_COUNT))
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t costUs;        /* Mean time the transition costs */
+    uint32_t maxCostUs;     /* Worst run */
+} PmCalibrationCost;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool PmCalibration_Init(void);
+bool PmCalibration_Run(void);
+bool PmCalibration_Save(void);
+uint32_t PmCalibration_GetCost(PmCalibrationTransition transition);
+uint32_t PmCalibration_GetMaxCost(PmCalibrationTransition transition);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PM_CALIBRATION_H */
+
+/* [] END OF FILE */
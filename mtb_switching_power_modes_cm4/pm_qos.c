@@ -0,0 +1,336 @@
+/***************************************************************************//**
+* \file pm_qos.c
+* \version 1.0
+*
+* \brief
+* Power management quality-of-service constraints. See pm_qos.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "app_sections.h"
+#include "pm_qos.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define PM_QOS_BUCKETS          32u
+#define PM_QOS_CLOCK_STEP_MHZ   5u
+
+/* SysPm callbacks: vetoes only */
+static const SysPmRegistryEntry pmQosSysPmEntries[] =
+{
+    { PmQos_DeepSleepCallback, CY_SYSPM_DEEPSLEEP, SYSPM_PHASE_CHECK_READY, SYSPM_PRIORITY_QOS },
+    { PmQos_UltraLowPowerCallback, CY_SYSPM_ULP, SYSPM_PHASE_CHECK_READY, SYSPM_PRIORITY_QOS },
+};
+
+const SysPmRegistryTable pmQosSysPmTable =
+{
+    pmQosSysPmEntries, sizeof(pmQosSysPmEntries) / sizeof(pmQosSysPmEntries[0])
+};
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Active requests per bucket, and the mask of the non-empty buckets */
+static uint8_t pmQosCount[PM_QOS_CLASS_COUNT][PM_QOS_BUCKETS];
+static uint32_t pmQosMask[PM_QOS_CLASS_COUNT];
+
+/* Cached aggregates */
+static uint32_t pmQosValue[PM_QOS_CLASS_COUNT] = { PM_QOS_NO_LATENCY_LIMIT, PM_QOS_NO_CLOCK_LIMIT };
+
+static uint32_t pmQosDeepSleepLatency = PM_QOS_DEEP_SLEEP_LATENCY_US;
+
+
+/*******************************************************************************
+* Function Name: PmQos_ToBucket
+****************************************************************************//**
+*
+* Returns the bucket of a value. Latency bucket b > 0 holds [2^(b-1), 2^b),
+* clock bucket b holds (5 * (b - 1), 5 * b] MHz.
+*
+*******************************************************************************/
+static uint32_t PmQos_ToBucket(PmQosClass qosClass, uint32_t value)
+{
+    uint32_t bucket;
+
+    if (PM_QOS_WAKE_LATENCY == qosClass)
+    {
+        bucket = (0u == value) ? 0u : (32u - __CLZ(value));
+    }
+    else
+    {
+        bucket = (value + PM_QOS_CLOCK_STEP_MHZ - 1u) / PM_QOS_CLOCK_STEP_MHZ;
+    }
+
+    return (bucket < PM_QOS_BUCKETS) ? bucket : (PM_QOS_BUCKETS - 1u);
+}
+
+/*******************************************************************************
+* Function Name: PmQos_Refresh
+****************************************************************************//**
+*
+* Recomputes the cached aggregate of a class from its bucket mask: the lowest
+* latency bound, or the highest clock bound.
+*
+*******************************************************************************/
+static void PmQos_Refresh(PmQosClass qosClass)
+{
+    uint32_t mask = pmQosMask[qosClass];
+    uint32_t bucket;
+
+    if (PM_QOS_WAKE_LATENCY == qosClass)
+    {
+        if (0u == mask)
+        {
+            pmQosValue[qosClass] = PM_QOS_NO_LATENCY_LIMIT;
+        }
+        else
+        {
+            bucket = __CLZ(__RBIT(mask));
+            pmQosValue[qosClass] = (0u == bucket) ? 0u : (1UL << (bucket - 1u));
+        }
+    }
+    else
+    {
+        if (0u == mask)
+        {
+            pmQosValue[qosClass] = PM_QOS_NO_CLOCK_LIMIT;
+        }
+        else
+        {
+            bucket = 31u - __CLZ(mask);
+            pmQosValue[qosClass] = bucket * PM_QOS_CLOCK_STEP_MHZ;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: PmQos_Insert
+****************************************************************************//**
+*
+* Counts req in the bucket of value. Must be called in a critical section.
+*
+*******************************************************************************/
+static void PmQos_Insert(PmQosRequest *req, uint32_t value)
+{
+    uint32_t bucket = PmQos_ToBucket(req->qosClass, value);
+
+    CY_ASSERT(pmQosCount[req->qosClass][bucket] < UINT8_MAX);
+    pmQosCount[req->qosClass][bucket]++;
+    pmQosMask[req->qosClass] |= 1UL << bucket;
+    req->bucket = (uint8_t)bucket;
+    req->active = true;
+}
+
+/*******************************************************************************
+* Function Name: PmQos_Erase
+****************************************************************************//**
+*
+* Uncounts req. Must be called in a critical section.
+*
+*******************************************************************************/
+static void PmQos_Erase(PmQosRequest *req)
+{
+    if (0u == --pmQosCount[req->qosClass][req->bucket])
+    {
+        pmQosMask[req->qosClass] &= ~(1UL << req->bucket);
+    }
+    req->active = false;
+}
+
+/*******************************************************************************
+* Function Name: PmQos_AddRequest
+****************************************************************************//**
+*
+* Activates req as a constraint of qosClass with value. req must stay valid
+* until it is removed.
+*
+*******************************************************************************/
+APP_HOT void PmQos_AddRequest(PmQosRequest *req, PmQosClass qosClass, uint32_t value)
+{
+    uint32_t interruptState;
+
+    CY_ASSERT(qosClass < PM_QOS_CLASS_COUNT);
+    CY_ASSERT(!req->active);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    req->qosClass = qosClass;
+    PmQos_Insert(req, value);
+    PmQos_Refresh(qosClass);
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: PmQos_UpdateRequest
+****************************************************************************//**
+*
+* Changes the value of an active request.
+*
+*******************************************************************************/
+APP_HOT void PmQos_UpdateRequest(PmQosRequest *req, uint32_t value)
+{
+    uint32_t interruptState;
+
+    CY_ASSERT(req->active);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    PmQos_Erase(req);
+    PmQos_Insert(req, value);
+    PmQos_Refresh(req->qosClass);
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: PmQos_RemoveRequest
+****************************************************************************//**
+*
+* Deactivates req.
+*
+*******************************************************************************/
+APP_HOT void PmQos_RemoveRequest(PmQosRequest *req)
+{
+    uint32_t interruptState;
+
+    CY_ASSERT(req->active);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    PmQos_Erase(req);
+    PmQos_Refresh(req->qosClass);
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: PmQos_GetWakeLatency
+****************************************************************************//**
+*
+* Returns the strictest wake-up latency constraint in microseconds, or
+* PM_QOS_NO_LATENCY_LIMIT.
+*
+*******************************************************************************/
+uint32_t PmQos_GetWakeLatency(void)
+{
+    return pmQosValue[PM_QOS_WAKE_LATENCY];
+}
+
+/*******************************************************************************
+* Function Name: PmQos_GetMinClock
+****************************************************************************//**
+*
+* Returns the strictest CLK_HF0 constraint in MHz, or PM_QOS_NO_CLOCK_LIMIT.
+*
+*******************************************************************************/
+uint32_t PmQos_GetMinClock(void)
+{
+    return pmQosValue[PM_QOS_MIN_CLOCK];
+}
+
+/*******************************************************************************
+* Function Name: PmQos_SetDeepSleepLatency
+****************************************************************************//**
+*
+* Replaces the estimated System Deep Sleep wake-up latency with a measured
+* one.
+*
+*******************************************************************************/
+void PmQos_SetDeepSleepLatency(uint32_t latencyUs)
+{
+    pmQosDeepSleepLatency = latencyUs;
+}
+
+/*******************************************************************************
+* Function Name: PmQos_IsDeepSleepAllowed
+****************************************************************************//**
+*
+* Returns true if the wake-up latency of System Deep Sleep meets the latency
+* constraint.
+*
+*******************************************************************************/
+APP_HOT bool PmQos_IsDeepSleepAllowed(void)
+{
+    return (pmQosDeepSleepLatency <= pmQosValue[PM_QOS_WAKE_LATENCY]);
+}
+
+/*******************************************************************************
+* Function Name: PmQos_IsUltraLowPowerAllowed
+****************************************************************************//**
+*
+* Returns true if the clock limit of System ULP meets the clock constraint.
+*
+*******************************************************************************/
+APP_HOT bool PmQos_IsUltraLowPowerAllowed(void)
+{
+    return (pmQosValue[PM_QOS_MIN_CLOCK] <= PM_QOS_ULP_MAX_CLOCK_MHZ);
+}
+
+/*******************************************************************************
+* Function Name: PmQos_DeepSleepCallback
+****************************************************************************//**
+*
+* Deep Sleep callback implementation. Refuses the transition while a latency
+* constraint rules it out.
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t PmQos_DeepSleepCallback(
+    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            retVal = PmQos_IsDeepSleepAllowed() ? CY_SYSPM_SUCCESS : CY_SYSPM_FAIL;
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+/*******************************************************************************
+* Function Name: PmQos_UltraLowPowerCallback
+****************************************************************************//**
+*
+* Enter System ULP callback implementation. Refuses the transition while a
+* clock constraint rules it out.
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t PmQos_UltraLowPowerCallback(
+    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            retVal = PmQos_IsUltraLowPowerAllowed() ? CY_SYSPM_SUCCESS : CY_SYSPM_FAIL;
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/***************************************************************************//**
+* \file pm_qos.h
+* \version 1.0
+*
+* \brief
+* Power management quality-of-service constraints.
+*
+* A subsystem that cannot tolerate a slow wake-up or a slow CPU adds a
+* request: a maximum wake-up latency (in microseconds) or a minimum CLK_HF0
+* frequency (in MHz). The power mode decisions respect the strictest active
+* request of each class:
+* - System Deep Sleep is only entered if its wake-up latency is within the
+*   latency constraint; otherwise the CPU only sleeps.
+* - System ULP is only entered if its clock limit meets the clock constraint.
+* - After System Deep Sleep, the CPU only resumes on the IMO if the IMO meets
+*   the clock constraint (see fast_wake.h).
+*
+* The telemetry log holds a minimum clock while it has pages waiting to be
+* written (see telemetry_log.h).
+*
+* Requests are counted in 32 buckets per class with a bitmask of the
+* non-empty buckets, so adding, updating and removing a request is O(1) and
+* the aggregate is always up to date. Values are rounded to the bucket bound
+* on the strict side: latencies down to a power of two, clocks up to a
+* multiple of 5 MHz.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PM_QOS_H)
+#define PM_QOS_H
+
+#include "cy_pdl.h"
+#include "syspm_registry.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+typedef enum
+{
+    PM_QOS_WAKE_LATENCY = 0u,   /* Maximum wake-up latency, in microseconds */
+    PM_QOS_MIN_CLOCK    = 1u,   /* Minimum CLK_HF0 frequency, in MHz */
+    PM_QOS_CLASS_COUNT  = 2u,
+} PmQosClass;
+
+/* Aggregates when no request is active */
+#define PM_QOS_NO_LATENCY_LIMIT         UINT32_MAX
+#define PM_QOS_NO_CLOCK_LIMIT           0u
+
+/* Wake-up latency of System Deep Sleep until the callbacks have run. The FLL
+ * locks in the background, see fast_wake.h. An estimate until it is
+ * measured, see PmQos_SetDeepSleepLatency(). */
+#define PM_QOS_DEEP_SLEEP_LATENCY_US    100u
+
+/* Highest CLK_HF0 frequency in System ULP */
+#define PM_QOS_ULP_MAX_CLOCK_MHZ        50u
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* A request, owned by the subsystem that adds it. Zero-initialize it. */
+typedef struct
+{
+    PmQosClass qosClass;
+    uint8_t bucket;
+    bool active;
+} PmQosRequest;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const SysPmRegistryTable pmQosSysPmTable;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void PmQos_AddRequest(PmQosRequest *req, PmQosClass qosClass, uint32_t value);
+void PmQos_UpdateRequest(PmQosRequest *req, uint32_t value);
+void PmQos_RemoveRequest(PmQosRequest *req);
+
+uint32_t PmQos_GetWakeLatency(void);
+uint32_t PmQos_GetMinClock(void);
+
+void PmQos_SetDeepSleepLatency(uint32_t latencyUs);
+bool PmQos_IsDeepSleepAllowed(void);
+bool PmQos_IsUltraLowPowerAllowed(void);
+
+cy_en_syspm_status_t PmQos_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+cy_en_syspm_status_t PmQos_UltraLowPowerCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PM_QOS_H */
+
+/* [] END OF FILE */
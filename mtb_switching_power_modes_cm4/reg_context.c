@@ -0,0 +1,69 @@
+/***************************************************************************//**
+* \file reg_context.c
+* \version 1.0
+*
+* \brief
+* Register context save and restore for the power mode callbacks. See
+* reg_context.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "app_sections.h"
+#include "reg_context.h"
+
+
+/*******************************************************************************
+* Function Name: RegContext_Save
+****************************************************************************//**
+*
+* Copies the registers of context into its snapshot.
+*
+*******************************************************************************/
+APP_HOT void RegContext_Save(const RegContext *context)
+{
+    const RegContextRange *range = context->ranges;
+    const RegContextRange *end = context->ranges + context->rangeCount;
+    uint32_t *snapshot = context->snapshot;
+    uint32_t reg;
+
+    for (; range != end; range++)
+    {
+        for (reg = 0u; reg < range->count; reg++)
+        {
+            *snapshot++ = range->first[reg];
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: RegContext_Restore
+****************************************************************************//**
+*
+* Writes the snapshot of context back to its registers, range by range in
+* table order.
+*
+*******************************************************************************/
+APP_HOT void RegContext_Restore(const RegContext *context)
+{
+    const RegContextRange *range = context->ranges;
+    const RegContextRange *end = context->ranges + context->rangeCount;
+    const uint32_t *snapshot = context->snapshot;
+    uint32_t reg;
+
+    for (; range != end; range++)
+    {
+        for (reg = 0u; reg < range->count; reg++)
+        {
+            range->first[reg] = *snapshot++;
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,68 @@
+/***************************************************************************//**
+* \file reg_context.h
+* \version 1.0
+*
+* \brief
+* Register context save and restore for the power mode callbacks.
+*
+* A peripheral declares the registers that make up its context as a const
+* table of ranges of contiguous registers, in the order they must be written
+* back, and a snapshot buffer with a word per register. RegContext_Save()
+* copies the registers into the snapshot before a transition, and
+* RegContext_Restore() writes them all back in one pass after it, instead of
+* a chain of driver calls.
+*
+* The registers of the PSoC 6 peripherals are retained in System Deep Sleep,
+* so the context is the state a callback changes or the counter phase it
+* wants back, not state lost by the hardware. Hibernate wakes up through a
+* reset, which also clears the snapshots in SRAM.
+*
+* Only word registers without side effects on read or write can be part of a
+* context: no status, interrupt or command registers.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(REG_CONTEXT_H)
+#define REG_CONTEXT_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    volatile uint32_t *first;       /* First register of the range */
+    uint32_t count;                 /* Number of contiguous registers */
+} RegContextRange;
+
+typedef struct
+{
+    const RegContextRange *ranges;  /* Ranges, in restore order */
+    uint32_t rangeCount;
+    uint32_t *snapshot;             /* A word per register of the ranges */
+} RegContext;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void RegContext_Save(const RegContext *context);
+void RegContext_Restore(const RegContext *context);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* REG_CONTEXT_H */
+
+/* [] END OF FILE */
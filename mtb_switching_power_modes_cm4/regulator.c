@@ -0,0 +1,54 @@
+/***************************************************************************//**
+* \file regulator.c
+* \version 1.0
+*
+* \brief
+* Core regulator selection at startup. See regulator.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "regulator.h"
+
+
+/*******************************************************************************
+* Function Name: Regulator_Init
+****************************************************************************//**
+*
+* Enables the SIMO buck if it is fitted, at the voltage of the current System
+* mode. Call once the CM0+ has configured the power system.
+*
+*******************************************************************************/
+void Regulator_Init(void)
+{
+#if defined(REGULATOR_BUCK_FITTED)
+    if (!Cy_SysPm_BuckIsEnabled())
+    {
+        if (CY_SYSPM_SUCCESS != Cy_SysPm_BuckEnable(Cy_SysPm_IsSystemUlp() ?
+            CY_SYSPM_BUCK_OUT1_VOLTAGE_ULP : CY_SYSPM_BUCK_OUT1_VOLTAGE_LP))
+        {
+            CY_ASSERT(0);
+        }
+    }
+#endif /* defined(REGULATOR_BUCK_FITTED) */
+}
+
+/*******************************************************************************
+* Function Name: Regulator_Get
+****************************************************************************//**
+*
+* Returns the active core regulator.
+*
+*******************************************************************************/
+RegulatorType Regulator_Get(void)
+{
+    return Cy_SysPm_BuckIsEnabled() ? REGULATOR_BUCK : REGULATOR_LDO;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,56 @@
+/***************************************************************************//**
+* \file regulator.h
+* \version 1.0
+*
+* \brief
+* Core regulator selection at startup.
+*
+* The device configuration starts on the LDO at 1.1 V. With
+* REGULATOR_BUCK_FITTED=1, for boards that have the buck inductor fitted, the
+* SIMO buck is enabled once at startup: at our load currents it draws much
+* less from VDDD than the LDO, in System LP and in System ULP alike.
+*
+* The PDL can switch from the LDO to the buck, but not back, and it sets the
+* voltage of whichever regulator is active when the System mode changes. So
+* the regulator is not changed with the System mode: the buck is enabled at
+* the voltage of the current mode and the PDL follows it from there.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(REGULATOR_H)
+#define REGULATOR_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+typedef enum
+{
+    REGULATOR_LDO   = 0u,
+    REGULATOR_BUCK  = 1u,
+} RegulatorType;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Regulator_Init(void);
+RegulatorType Regulator_Get(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* REGULATOR_H */
+
+/* [] END OF FILE */
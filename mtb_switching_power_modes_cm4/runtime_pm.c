@@ -0,0 +1,299 @@
+/***************************************************************************//**
+* \file runtime_pm.c
+* \version 1.0
+*
+* \brief
+* Runtime power management of the peripherals. See runtime_pm.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "app_sections.h"
+#include "clock_manager.h"
+#include "smif_mem.h"
+#include "time_base.h"
+#include "runtime_pm.h"
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void RuntimePm_ResumePwm(void);
+static bool RuntimePm_SuspendPwm(void);
+static void RuntimePm_ResumeCounter(void);
+static bool RuntimePm_SuspendCounter(void);
+static void RuntimePm_ResumeCsd(void);
+static bool RuntimePm_SuspendCsd(void);
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+typedef struct
+{
+    void (*resume)(void);           /* Clocks and enables the peripheral */
+    bool (*suspend)(void);          /* Disables and unclocks it, false if it cannot */
+    uint32_t delayMs;               /* Autosuspend delay */
+} RuntimePmOps;
+
+static const RuntimePmOps runtimePmOps[RUNTIME_PM_DEV_COUNT] =
+{
+    [RUNTIME_PM_DEV_LED_PWM] = { RuntimePm_ResumePwm, RuntimePm_SuspendPwm, RUNTIME_PM_LED_PWM_DELAY_MS },
+    [RUNTIME_PM_DEV_COUNTER] = { RuntimePm_ResumeCounter, RuntimePm_SuspendCounter, RUNTIME_PM_COUNTER_DELAY_MS },
+    [RUNTIME_PM_DEV_SMIF]    = { SmifMem_Resume, SmifMem_Suspend, RUNTIME_PM_SMIF_DELAY_MS },
+    [RUNTIME_PM_DEV_CSD]     = { RuntimePm_ResumeCsd, RuntimePm_SuspendCsd, RUNTIME_PM_CSD_DELAY_MS },
+};
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+typedef struct
+{
+    uint8_t usage;                  /* Outstanding RuntimePm_Get() calls */
+    bool active;                    /* Resumed */
+    uint64_t lastBusy;              /* Time of the last RuntimePm_Put() */
+} RuntimePmState;
+
+static RuntimePmState runtimePmState[RUNTIME_PM_DEV_COUNT];
+
+
+/*******************************************************************************
+* Function Name: RuntimePm_ResumePwm
+****************************************************************************//**
+*
+* Clocks and starts KIT_LED1_PWM.
+*
+*******************************************************************************/
+static APP_HOT void RuntimePm_ResumePwm(void)
+{
+    ClockManager_Acquire(CLOCK_MANAGER_CLK_TCPWM_DIV);
+    Cy_TCPWM_PWM_Enable(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM);
+    Cy_TCPWM_TriggerStart(KIT_LED1_PWM_HW, KIT_LED1_PWM_MASK);
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_SuspendPwm
+****************************************************************************//**
+*
+* Stops and unclocks KIT_LED1_PWM.
+*
+*******************************************************************************/
+static APP_HOT bool RuntimePm_SuspendPwm(void)
+{
+    Cy_TCPWM_PWM_Disable(KIT_LED1_PWM_HW, KIT_LED1_PWM_NUM);
+    ClockManager_Release(CLOCK_MANAGER_CLK_TCPWM_DIV);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_ResumeCounter
+****************************************************************************//**
+*
+* Clocks and enables APP_COUNTER. It starts counting on its start trigger.
+*
+*******************************************************************************/
+static APP_HOT void RuntimePm_ResumeCounter(void)
+{
+    ClockManager_Acquire(CLOCK_MANAGER_CLK_TCPWM_DIV);
+    Cy_TCPWM_Counter_Enable(APP_COUNTER_HW, APP_COUNTER_NUM);
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_SuspendCounter
+****************************************************************************//**
+*
+* Disables and unclocks APP_COUNTER.
+*
+*******************************************************************************/
+static APP_HOT bool RuntimePm_SuspendCounter(void)
+{
+    Cy_TCPWM_Counter_Disable(APP_COUNTER_HW, APP_COUNTER_NUM);
+    ClockManager_Release(CLOCK_MANAGER_CLK_TCPWM_DIV);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_ResumeCsd
+****************************************************************************//**
+*
+* Clocks CSD0. The block itself is enabled by its middleware.
+*
+*******************************************************************************/
+static void RuntimePm_ResumeCsd(void)
+{
+    ClockManager_Acquire(CLOCK_MANAGER_CLK_CSD_DIV);
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_SuspendCsd
+****************************************************************************//**
+*
+* Unclocks CSD0.
+*
+*******************************************************************************/
+static bool RuntimePm_SuspendCsd(void)
+{
+    ClockManager_Release(CLOCK_MANAGER_CLK_CSD_DIV);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_Init
+****************************************************************************//**
+*
+* Starts runtime PM. The SMIF is active after SmifMem_Init() and will be
+* autosuspended; the other peripherals start suspended. Requires
+* TimeBase_Init().
+*
+*******************************************************************************/
+void RuntimePm_Init(void)
+{
+    uint64_t now = TimeBase_GetTicks();
+    uint32_t dev;
+
+    for (dev = 0u; dev < (uint32_t)RUNTIME_PM_DEV_COUNT; dev++)
+    {
+        runtimePmState[dev].usage = 0u;
+        runtimePmState[dev].active = false;
+        runtimePmState[dev].lastBusy = now;
+    }
+
+    runtimePmState[RUNTIME_PM_DEV_SMIF].active = true;
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_Get
+****************************************************************************//**
+*
+* Takes a usage reference on dev and resumes it if it is suspended. Not for
+* interrupt handlers: the resume runs with interrupts enabled. The reference
+* is taken first, so a Suspend from an interrupt cannot undo the resume.
+*
+*******************************************************************************/
+APP_HOT void RuntimePm_Get(RuntimePmDevice dev)
+{
+    RuntimePmState *state;
+    uint32_t interruptState;
+    bool resume;
+
+    CY_ASSERT(dev < RUNTIME_PM_DEV_COUNT);
+    state = &runtimePmState[dev];
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    CY_ASSERT(state->usage < UINT8_MAX);
+    state->usage++;
+    resume = !state->active;
+    state->active = true;
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (resume)
+    {
+        runtimePmOps[dev].resume();
+    }
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_Put
+****************************************************************************//**
+*
+* Drops a usage reference on dev. The last one starts its autosuspend delay.
+*
+*******************************************************************************/
+APP_HOT void RuntimePm_Put(RuntimePmDevice dev)
+{
+    RuntimePmState *state;
+    uint64_t now = TimeBase_GetTicks();
+    uint32_t interruptState;
+
+    CY_ASSERT(dev < RUNTIME_PM_DEV_COUNT);
+    state = &runtimePmState[dev];
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    CY_ASSERT(0u != state->usage);
+    state->usage--;
+    state->lastBusy = now;
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_Suspend
+****************************************************************************//**
+*
+* Suspends dev now if it is idle. Returns true if dev is suspended.
+*
+*******************************************************************************/
+APP_HOT bool RuntimePm_Suspend(RuntimePmDevice dev)
+{
+    RuntimePmState *state;
+    uint32_t interruptState;
+    bool suspended;
+
+    CY_ASSERT(dev < RUNTIME_PM_DEV_COUNT);
+    state = &runtimePmState[dev];
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    if (state->active && (0u == state->usage) && runtimePmOps[dev].suspend())
+    {
+        state->active = false;
+    }
+    suspended = !state->active;
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    return suspended;
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_IsActive
+****************************************************************************//**
+*
+* Returns true if dev is resumed.
+*
+*******************************************************************************/
+bool RuntimePm_IsActive(RuntimePmDevice dev)
+{
+    CY_ASSERT(dev < RUNTIME_PM_DEV_COUNT);
+
+    return runtimePmState[dev].active;
+}
+
+/*******************************************************************************
+* Function Name: RuntimePm_Process
+****************************************************************************//**
+*
+* Suspends the peripherals that have been idle for longer than their
+* autosuspend delay. Call it from the main loop.
+*
+*******************************************************************************/
+void RuntimePm_Process(void)
+{
+    uint64_t now = TimeBase_GetTicks();
+    uint32_t dev;
+
+    for (dev = 0u; dev < (uint32_t)RUNTIME_PM_DEV_COUNT; dev++)
+    {
+        if (runtimePmState[dev].active && (0u == runtimePmState[dev].usage) &&
+            ((now - runtimePmState[dev].lastBusy) >= TIME_BASE_MS_TO_TICKS(runtimePmOps[dev].delayMs)))
+        {
+            (void)RuntimePm_Suspend((RuntimePmDevice)dev);
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,71 @@
+/***************************************************************************//**
+* \file runtime_pm.h
+* \version 1.0
+*
+* \brief
+* Runtime power management of the peripherals of the CM4 application.
+*
+* Each peripheral has a usage count. A driver calls RuntimePm_Get() before it
+* uses the peripheral, which resumes it (clocks it and enables it) if it was
+* suspended, and RuntimePm_Put() when it is done. A peripheral that has been
+* idle (usage count 0) for longer than its autosuspend delay is suspended
+* (disabled and unclocked) by RuntimePm_Process(), called from the main loop.
+* RuntimePm_Suspend() suspends an idle peripheral at once, for the power mode
+* callbacks.
+*
+* Put and Suspend can be called from interrupt handlers. Get cannot: it
+* resumes the peripheral outside of its critical section, because a resume
+* can be slow (the SMIF one restarts CLK_HF2).
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(RUNTIME_PM_H)
+#define RUNTIME_PM_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+typedef enum
+{
+    RUNTIME_PM_DEV_LED_PWM  = 0u,   /* KIT_LED1_PWM */
+    RUNTIME_PM_DEV_COUNTER  = 1u,   /* APP_COUNTER, times the button presses */
+    RUNTIME_PM_DEV_SMIF     = 2u,   /* SMIF and the QSPI memory */
+    RUNTIME_PM_DEV_CSD      = 3u,   /* CSD0, no user in this application */
+    RUNTIME_PM_DEV_COUNT    = 4u,
+} RuntimePmDevice;
+
+/* Autosuspend delays */
+#define RUNTIME_PM_LED_PWM_DELAY_MS     0u
+#define RUNTIME_PM_COUNTER_DELAY_MS     250u    /* Covers the debounce of the next press */
+#define RUNTIME_PM_SMIF_DELAY_MS        1000u   /* Covers the next page of the log */
+#define RUNTIME_PM_CSD_DELAY_MS         0u
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void RuntimePm_Init(void);
+void RuntimePm_Get(RuntimePmDevice dev);
+void RuntimePm_Put(RuntimePmDevice dev);
+bool RuntimePm_Suspend(RuntimePmDevice dev);
+bool RuntimePm_IsActive(RuntimePmDevice dev);
+void RuntimePm_Process(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RUNTIME_PM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,188 @@
+/***************************************************************************//**
+* \file section_bench.c
+* \version 1.0
+*
+* \brief
+* Benchmark of the code placements of app_sections.h. See section_bench.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if defined(SECTION_BENCH)
+
+#include "cy_pdl.h"
+#include "app_sections.h"
+#include "cycle_counter.h"
+#include "smif_mem.h"
+#include "runtime_pm.h"
+#include "section_bench.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Iterations of the probe loop */
+#define SECTION_BENCH_LOOPS     64u
+
+typedef uint32_t (*SectionBenchProbe)(uint32_t seed);
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+volatile SectionBenchResult sectionBenchResult;
+
+/* Keeps the probe results alive */
+static volatile uint32_t sectionBenchSink;
+
+
+/*******************************************************************************
+* Function Name: SectionBench_Work
+****************************************************************************//**
+*
+* Probe workload: a short loop with data-dependent branches, similar in size
+* to a callback. Always inlined, so every placement gets its own copy.
+*
+*******************************************************************************/
+__STATIC_FORCEINLINE uint32_t SectionBench_Work(uint32_t seed)
+{
+    uint32_t acc = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < SECTION_BENCH_LOOPS; i++)
+    {
+        seed ^= seed << 13u;
+        seed ^= seed >> 17u;
+        seed ^= seed << 5u;
+        if (0u != (seed & 1u))
+        {
+            acc += seed >> 3u;
+        }
+        else
+        {
+            acc ^= seed;
+        }
+    }
+
+    return acc;
+}
+
+/*******************************************************************************
+* Function Name: SectionBench_ProbeFlash
+****************************************************************************//**
+*
+* Probe routine in internal flash.
+*
+*******************************************************************************/
+static CY_NOINLINE uint32_t SectionBench_ProbeFlash(uint32_t seed)
+{
+    return SectionBench_Work(seed);
+}
+
+/*******************************************************************************
+* Function Name: SectionBench_ProbeRam
+****************************************************************************//**
+*
+* Probe routine in SRAM.
+*
+*******************************************************************************/
+static APP_SECTION_RAMFUNC uint32_t SectionBench_ProbeRam(uint32_t seed)
+{
+    return SectionBench_Work(seed);
+}
+
+/*******************************************************************************
+* Function Name: SectionBench_ProbeXip
+****************************************************************************//**
+*
+* Probe routine executing in place from the QSPI memory.
+*
+*******************************************************************************/
+static APP_SECTION_XIP uint32_t SectionBench_ProbeXip(uint32_t seed)
+{
+    return SectionBench_Work(seed);
+}
+
+/*******************************************************************************
+* Function Name: SectionBench_Measure
+****************************************************************************//**
+*
+* Returns the cycles taken by one call of probe, with interrupts disabled.
+*
+*******************************************************************************/
+static uint32_t SectionBench_Measure(SectionBenchProbe probe)
+{
+    uint32_t interruptState;
+    uint32_t start;
+    uint32_t result;
+    uint32_t cycles;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    start = CycleCounter_Get();
+    result = probe(start);
+    cycles = CycleCounter_Get() - start;
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    sectionBenchSink += result;
+
+    return cycles;
+}
+
+/*******************************************************************************
+* Function Name: SectionBench_MeasureAll
+****************************************************************************//**
+*
+* Times the probe routine in each placement in the current power mode. XIP is
+* skipped when the QSPI memory is not available.
+*
+*******************************************************************************/
+static void SectionBench_MeasureAll(volatile SectionBenchCycles *cycles, bool xip)
+{
+    /* Warm up the flash cache first */
+    (void)SectionBench_Measure(SectionBench_ProbeFlash);
+    cycles->flash = SectionBench_Measure(SectionBench_ProbeFlash);
+    cycles->ram = SectionBench_Measure(SectionBench_ProbeRam);
+
+    if (xip)
+    {
+        RuntimePm_Get(RUNTIME_PM_DEV_SMIF);
+        Cy_SMIF_CacheInvalidate(SMIF_MEM_HW, CY_SMIF_CACHE_BOTH);
+        cycles->xipCold = SectionBench_Measure(SectionBench_ProbeXip);
+        cycles->xipWarm = SectionBench_Measure(SectionBench_ProbeXip);
+        RuntimePm_Put(RUNTIME_PM_DEV_SMIF);
+    }
+}
+
+/*******************************************************************************
+* Function Name: SectionBench_Run
+****************************************************************************//**
+*
+* Times the probe routine in each placement in System LP and in System ULP,
+* and returns to System LP. The SysPm callbacks must be registered, so that
+* the clocks are within the ULP limits, and the QSPI memory must be
+* memory-mapped and idle.
+*
+*******************************************************************************/
+void SectionBench_Run(void)
+{
+    /* The cycle counter runs from reset (see boot_profile.h) */
+    SectionBench_MeasureAll(&sectionBenchResult.lp, true);
+
+    /* CLK_HF2 is stopped in System ULP (see clock_manager.h) */
+    if (CY_SYSPM_SUCCESS == Cy_SysPm_SystemEnterUlp())
+    {
+        SectionBench_MeasureAll(&sectionBenchResult.ulp, false);
+        (void)Cy_SysPm_SystemEnterLp();
+    }
+}
+
+#endif /* defined(SECTION_BENCH) */
+
+/* [] END OF FILE */
@@ -0,0 +1,64 @@
+/***************************************************************************//**
+* \file section_bench.h
+* \version 1.0
+*
+* \brief
+* Benchmark of the code placements of app_sections.h. The same probe routine
+* is linked into each placement and timed with the CPU cycle counter, in
+* System LP and in System ULP. Results are left in sectionBenchResult for
+* inspection with the debugger.
+*
+* Build with SECTION_BENCH=1 to run the benchmark at startup.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(SECTION_BENCH_H)
+#define SECTION_BENCH_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Cycles of one call of the probe routine */
+typedef struct
+{
+    uint32_t flash;         /* Internal flash */
+    uint32_t ram;           /* SRAM (.cy_ramfunc) */
+    uint32_t xipCold;       /* QSPI, first call after invalidating the SMIF cache */
+    uint32_t xipWarm;       /* QSPI, repeated call */
+} SectionBenchCycles;
+
+typedef struct
+{
+    SectionBenchCycles lp;  /* System LP, clk_hf0 at 100 MHz */
+    SectionBenchCycles ulp; /* System ULP, clk_hf0 at 50 MHz, no XIP */
+} SectionBenchResult;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern volatile SectionBenchResult sectionBenchResult;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void SectionBench_Run(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SECTION_BENCH_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,473 @@
+/***************************************************************************//**
+* \file smif_mem.c
+* \version 1.0
+*
+* \brief
+* Driver for the external QSPI memory on SMIF slot 0 (S25FL512S).
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "app_sections.h"
+#include "clock_manager.h"
+#include "smif_mem.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define SMIF_MEM_DEVICE     ((cy_stc_smif_mem_config_t *)smifMemConfigs[0])
+#define SMIF_MEM_ADDR_SIZE  4u
+
+/* QSPI pins of the CY8CPROTO-062-4343W kit (not part of the design.modus) */
+#define SMIF_MEM_PORT       GPIO_PRT11
+#define SMIF_MEM_SS_NUM     2u
+#define SMIF_MEM_D3_NUM     3u
+#define SMIF_MEM_D2_NUM     4u
+#define SMIF_MEM_D1_NUM     5u
+#define SMIF_MEM_D0_NUM     6u
+#define SMIF_MEM_CLK_NUM    7u
+
+/* Flash operations that keep the block in command mode */
+typedef enum
+{
+    SMIF_MEM_OP_NONE    = 0u,
+    SMIF_MEM_OP_PROGRAM = 1u,
+    SMIF_MEM_OP_ERASE   = 2u,
+} SmifMemOp;
+
+/* SysPm callbacks */
+static const SysPmRegistryEntry smifMemSysPmEntries[] =
+{
+    { SmifMem_DeepSleepCallback, CY_SYSPM_DEEPSLEEP,
+      SYSPM_PHASE_CHECK_READY | SYSPM_PHASE_BEFORE_TRANSITION | SYSPM_PHASE_AFTER_TRANSITION,
+      SYSPM_PRIORITY_PERIPHERAL },
+};
+
+const SysPmRegistryTable smifMemSysPmTable =
+{
+    smifMemSysPmEntries, sizeof(smifMemSysPmEntries) / sizeof(smifMemSysPmEntries[0])
+};
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cy_stc_smif_context_t smifContext;
+static volatile SmifMemOp smifOp = SMIF_MEM_OP_NONE;
+static uint32_t smifSuspendCount = 0u;      /* Nested SmifMem_Suspend() calls */
+static bool smifSleepSuspend = false;       /* Suspended by the Deep Sleep callback */
+
+
+/*******************************************************************************
+* Function Name: SmifMem_OffsetToAddress
+****************************************************************************//**
+*
+* Converts an offset into the memory to the big-endian address array used by
+* the SMIF memory slot commands.
+*
+*******************************************************************************/
+static void SmifMem_OffsetToAddress(uint32_t offset, uint8_t addr[SMIF_MEM_ADDR_SIZE])
+{
+    addr[0] = (uint8_t)(offset >> 24u);
+    addr[1] = (uint8_t)(offset >> 16u);
+    addr[2] = (uint8_t)(offset >> 8u);
+    addr[3] = (uint8_t)(offset);
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_WaitBlockIdle
+****************************************************************************//**
+*
+* Waits until the SMIF block has finished the current transfer.
+*
+*******************************************************************************/
+static bool SmifMem_WaitBlockIdle(uint32_t timeoutUs)
+{
+    while (Cy_SMIF_BusyCheck(SMIF_MEM_HW) && (0u != timeoutUs))
+    {
+        Cy_SysLib_DelayUs(1u);
+        timeoutUs--;
+    }
+
+    return (!Cy_SMIF_BusyCheck(SMIF_MEM_HW));
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_SendCommand
+****************************************************************************//**
+*
+* Sends a single-byte command without parameters and waits for it to complete.
+* The block must be in command mode.
+*
+*******************************************************************************/
+static cy_en_smif_status_t SmifMem_SendCommand(uint8_t cmd)
+{
+    cy_en_smif_status_t status;
+
+    status = Cy_SMIF_TransmitCommand(SMIF_MEM_HW, cmd, CY_SMIF_WIDTH_SINGLE,
+                                     NULL, CY_SMIF_CMD_WITHOUT_PARAM, CY_SMIF_WIDTH_NA,
+                                     SMIF_MEM_SLOT, CY_SMIF_TX_LAST_BYTE, &smifContext);
+
+    if ((CY_SMIF_SUCCESS == status) && !SmifMem_WaitBlockIdle(SMIF_MEM_TIMEOUT_US))
+    {
+        status = CY_SMIF_EXCEED_TIMEOUT;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_StartOperation
+****************************************************************************//**
+*
+* Switches the block to command mode and sets the write enable latch, ready for
+* a program or erase command. Once in command mode the operation is tracked,
+* so SmifMem_IsBusy() restores memory-mapped mode even if the command fails.
+*
+*******************************************************************************/
+static cy_en_smif_status_t SmifMem_StartOperation(SmifMemOp op)
+{
+    /* Only one operation at a time */
+    if (SmifMem_IsBusy())
+    {
+        return CY_SMIF_BUSY;
+    }
+
+    Cy_SMIF_SetMode(SMIF_MEM_HW, CY_SMIF_NORMAL);
+    smifOp = op;
+
+    return Cy_SMIF_Memslot_CmdWriteEnable(SMIF_MEM_HW, SMIF_MEM_DEVICE, &smifContext);
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_Init
+****************************************************************************//**
+*
+* Configures the QSPI pins and the SMIF block, enables quad mode on the memory
+* and leaves it memory-mapped at SMIF_MEM_BASE_ADDR. The SMIF block runs from
+* CLK_HF2, which is held until SmifMem_Suspend().
+*
+*******************************************************************************/
+cy_en_smif_status_t SmifMem_Init(void)
+{
+    cy_en_smif_status_t status;
+
+    const cy_stc_smif_config_t smifConfig =
+    {
+        .mode          = (uint32_t)CY_SMIF_NORMAL,
+        .deselectDelay = 1u,
+        .rxClockSel    = (uint32_t)CY_SMIF_SEL_INV_INTERNAL_CLK,
+        .blockEvent    = (uint32_t)CY_SMIF_BUS_ERROR
+    };
+
+    const cy_stc_sysint_t smifIsr =
+    {
+        .intrSrc      = SMIF_MEM_IRQ,
+        .intrPriority = SMIF_MEM_INTR_PRIORITY,
+    };
+
+    /* The SMIF block runs from CLK_HF2 while the memory is powered up */
+    ClockManager_Acquire(CLOCK_MANAGER_CLK_HF2);
+
+    /* Route the QSPI pins to the SMIF block */
+    (void)Cy_GPIO_Pin_FastInit(SMIF_MEM_PORT, SMIF_MEM_SS_NUM, CY_GPIO_DM_STRONG_IN_OFF, 1u, P11_2_SMIF_SPI_SELECT0);
+    (void)Cy_GPIO_Pin_FastInit(SMIF_MEM_PORT, SMIF_MEM_D3_NUM, CY_GPIO_DM_STRONG, 1u, P11_3_SMIF_SPI_DATA3);
+    (void)Cy_GPIO_Pin_FastInit(SMIF_MEM_PORT, SMIF_MEM_D2_NUM, CY_GPIO_DM_STRONG, 1u, P11_4_SMIF_SPI_DATA2);
+    (void)Cy_GPIO_Pin_FastInit(SMIF_MEM_PORT, SMIF_MEM_D1_NUM, CY_GPIO_DM_STRONG, 1u, P11_5_SMIF_SPI_DATA1);
+    (void)Cy_GPIO_Pin_FastInit(SMIF_MEM_PORT, SMIF_MEM_D0_NUM, CY_GPIO_DM_STRONG, 1u, P11_6_SMIF_SPI_DATA0);
+    (void)Cy_GPIO_Pin_FastInit(SMIF_MEM_PORT, SMIF_MEM_CLK_NUM, CY_GPIO_DM_STRONG_IN_OFF, 1u, P11_7_SMIF_SPI_CLK);
+
+    status = Cy_SMIF_Init(SMIF_MEM_HW, &smifConfig, SMIF_MEM_TIMEOUT_US, &smifContext);
+    if (CY_SMIF_SUCCESS != status)
+    {
+        return status;
+    }
+
+    Cy_SMIF_SetDataSelect(SMIF_MEM_HW, SMIF_MEM_SLOT, CY_SMIF_DATA_SEL0);
+
+    /* The interrupt refills the TX FIFO during page programs */
+    (void)Cy_SysInt_Init(&smifIsr, SmifMem_InterruptHandler);
+    NVIC_EnableIRQ(smifIsr.intrSrc);
+
+    Cy_SMIF_Enable(SMIF_MEM_HW, &smifContext);
+
+    status = Cy_SMIF_Memslot_Init(SMIF_MEM_HW, (cy_stc_smif_block_config_t *)&smifBlockConfig, &smifContext);
+    if (CY_SMIF_SUCCESS != status)
+    {
+        return status;
+    }
+
+    status = Cy_SMIF_Memslot_QuadEnable(SMIF_MEM_HW, SMIF_MEM_DEVICE, &smifContext);
+    if (CY_SMIF_SUCCESS != status)
+    {
+        return status;
+    }
+
+    while (Cy_SMIF_Memslot_IsBusy(SMIF_MEM_HW, SMIF_MEM_DEVICE, &smifContext))
+    {
+        /* Wait until the status register write completes */
+    }
+
+    Cy_SMIF_SetMode(SMIF_MEM_HW, CY_SMIF_MEMORY);
+
+    return CY_SMIF_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_IsBusy
+****************************************************************************//**
+*
+* Returns true while a program or erase operation is in progress. When the
+* operation has completed, the block is returned to memory-mapped mode.
+*
+*******************************************************************************/
+bool SmifMem_IsBusy(void)
+{
+    if (SMIF_MEM_OP_NONE == smifOp)
+    {
+        return false;
+    }
+
+    /* Page data may still be streaming out of the TX FIFO */
+    if (Cy_SMIF_BusyCheck(SMIF_MEM_HW))
+    {
+        return true;
+    }
+
+    /* Poll the Write-In-Progress bit of the memory */
+    if (Cy_SMIF_Memslot_IsBusy(SMIF_MEM_HW, SMIF_MEM_DEVICE, &smifContext))
+    {
+        return true;
+    }
+
+    smifOp = SMIF_MEM_OP_NONE;
+    Cy_SMIF_SetMode(SMIF_MEM_HW, CY_SMIF_MEMORY);
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_IsErasing
+****************************************************************************//**
+*
+* Returns true while a sector erase is in progress.
+*
+*******************************************************************************/
+APP_HOT bool SmifMem_IsErasing(void)
+{
+    return (SMIF_MEM_OP_ERASE == smifOp) && SmifMem_IsBusy();
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_FinishProgram
+****************************************************************************//**
+*
+* Waits for a page program in progress, bounded by its worst-case time
+* (SMIF_MEM_PROGRAM_TIME_US). Returns false if a program or erase is still in
+* progress.
+*
+*******************************************************************************/
+APP_HOT bool SmifMem_FinishProgram(void)
+{
+    uint32_t timeoutUs;
+
+    for (timeoutUs = SMIF_MEM_PROGRAM_TIME_US;
+         (SMIF_MEM_OP_PROGRAM == smifOp) && SmifMem_IsBusy() && (0u != timeoutUs); timeoutUs--)
+    {
+        Cy_SysLib_DelayUs(1u);
+    }
+
+    return !SmifMem_IsBusy();
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_EraseSector
+****************************************************************************//**
+*
+* Starts erasing the sector that contains offset. The function returns as soon
+* as the command is sent; an erase takes up to SMIF_MEM_ERASE_TIME_MS.
+*
+*******************************************************************************/
+cy_en_smif_status_t SmifMem_EraseSector(uint32_t offset)
+{
+    uint8_t addr[SMIF_MEM_ADDR_SIZE];
+    cy_en_smif_status_t status;
+
+    status = SmifMem_StartOperation(SMIF_MEM_OP_ERASE);
+    if (CY_SMIF_SUCCESS == status)
+    {
+        SmifMem_OffsetToAddress(offset, addr);
+        status = Cy_SMIF_Memslot_CmdSectorErase(SMIF_MEM_HW, SMIF_MEM_DEVICE, addr, &smifContext);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_ProgramPage
+****************************************************************************//**
+*
+* Starts programming one page (SMIF_MEM_PAGE_SIZE bytes) at a page-aligned
+* offset. The data is sent from the interrupt, so the buffer must stay
+* unchanged until SmifMem_IsBusy() returns false.
+*
+*******************************************************************************/
+cy_en_smif_status_t SmifMem_ProgramPage(uint32_t offset, const uint8_t *data)
+{
+    uint8_t addr[SMIF_MEM_ADDR_SIZE];
+    cy_en_smif_status_t status;
+
+    status = SmifMem_StartOperation(SMIF_MEM_OP_PROGRAM);
+    if (CY_SMIF_SUCCESS == status)
+    {
+        SmifMem_OffsetToAddress(offset, addr);
+        status = Cy_SMIF_Memslot_CmdProgram(SMIF_MEM_HW, SMIF_MEM_DEVICE, addr, (uint8_t *)data,
+                                            SMIF_MEM_PAGE_SIZE, NULL, &smifContext);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_GetMappedAddress
+****************************************************************************//**
+*
+* Returns the memory-mapped address of offset. The contents can only be read
+* while SmifMem_IsBusy() returns false.
+*
+*******************************************************************************/
+const uint8_t *SmifMem_GetMappedAddress(uint32_t offset)
+{
+    return (const uint8_t *)(SMIF_MEM_BASE_ADDR + offset);
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_InterruptHandler
+****************************************************************************//**
+*
+* SMIF interrupt handler. Services the TX/RX FIFOs of the current transfer.
+*
+*******************************************************************************/
+void SmifMem_InterruptHandler(void)
+{
+    Cy_SMIF_Interrupt(SMIF_MEM_HW, &smifContext);
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_Suspend
+****************************************************************************//**
+*
+* Leaves memory-mapped mode and releases CLK_HF2. The memory stays in standby.
+* Calls nest: only the first one changes anything. Returns false, without
+* changing anything, while a program or erase operation is in progress.
+*
+*******************************************************************************/
+APP_HOT bool SmifMem_Suspend(void)
+{
+    if (0u == smifSuspendCount)
+    {
+        if (SmifMem_IsBusy())
+        {
+            return false;
+        }
+
+        /* XIP accesses fail instead of stalling while the block is unclocked */
+        Cy_SMIF_SetMode(SMIF_MEM_HW, CY_SMIF_NORMAL);
+        ClockManager_Release(CLOCK_MANAGER_CLK_HF2);
+    }
+
+    smifSuspendCount++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_Resume
+****************************************************************************//**
+*
+* Undoes one SmifMem_Suspend() call. The last one acquires CLK_HF2 and
+* restores memory-mapped mode.
+*
+*******************************************************************************/
+APP_HOT void SmifMem_Resume(void)
+{
+    if (0u != smifSuspendCount)
+    {
+        smifSuspendCount--;
+        if (0u == smifSuspendCount)
+        {
+            ClockManager_Acquire(CLOCK_MANAGER_CLK_HF2);
+            Cy_SMIF_SetMode(SMIF_MEM_HW, CY_SMIF_MEMORY);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: SmifMem_DeepSleepCallback
+****************************************************************************//**
+*
+* Deep Sleep callback implementation. It refuses Deep Sleep while a sector
+* erase (up to SMIF_MEM_ERASE_TIME_MS) is in progress. Before the transition
+* it drains any page program and suspends the driver; after the transition it
+* resumes it. If the driver is already suspended (System ULP), the SMIF block
+* is not accessed.
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t SmifMem_DeepSleepCallback(
+    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            /* An erase takes far too long to wait for */
+            retVal = SmifMem_IsErasing() ? CY_SYSPM_FAIL : CY_SYSPM_SUCCESS;
+            break;
+
+        case CY_SYSPM_BEFORE_TRANSITION:
+            /* A program that overran its worst-case time completes on its
+             * own, SmifMem_IsBusy() picks up the result after wake-up */
+            if (!SmifMem_FinishProgram())
+            {
+                retVal = CY_SYSPM_SUCCESS;
+                break;
+            }
+
+            /* Release CLK_HF2, the memory stays in standby */
+            if (SmifMem_Suspend())
+            {
+                smifSleepSuspend = true;
+                retVal = CY_SYSPM_SUCCESS;
+            }
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            if (smifSleepSuspend)
+            {
+                /* Go back to XIP */
+                SmifMem_Resume();
+                smifSleepSuspend = false;
+            }
+
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/***************************************************************************//**
+* \file smif_mem.h
+* \version 1.0
+*
+* \brief
+* Driver for the external QSPI memory on SMIF slot 0 (S25FL512S).
+*
+* The memory is kept in memory-mapped (XIP) mode whenever it is idle. Program
+* and erase operations switch the block to command mode and are non-blocking;
+* SmifMem_IsBusy() polls for completion and returns the block to memory-mapped
+* mode when done. A Deep Sleep callback refuses System Deep Sleep during a
+* sector erase, and otherwise suspends the driver around it: it stops
+* memory-mapped accesses and releases CLK_HF2, and the memory stays in
+* standby. The S25FL512S has no deep power-down mode (B9h is a bank register
+* command on this part), so standby is its lowest power state.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(SMIF_MEM_H)
+#define SMIF_MEM_H
+
+#include "cy_pdl.h"
+#include "cycfg_qspi_memslot.h"
+#include "syspm_registry.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define SMIF_MEM_HW                 SMIF0
+#define SMIF_MEM_SLOT               CY_SMIF_SLAVE_SELECT_0
+#define SMIF_MEM_IRQ                smif_interrupt_IRQn
+#define SMIF_MEM_INTR_PRIORITY      3u
+
+/* Geometry of the memory, from the QSPI Configurator */
+#define SMIF_MEM_BASE_ADDR          (S25FL512S_4byteaddr_SlaveSlot_0.baseAddress)
+#define SMIF_MEM_SIZE               (deviceCfg_S25FL512S_4byteaddr_SlaveSlot_0.memSize)
+#define SMIF_MEM_PAGE_SIZE          (deviceCfg_S25FL512S_4byteaddr_SlaveSlot_0.programSize)
+#define SMIF_MEM_SECTOR_SIZE        (deviceCfg_S25FL512S_4byteaddr_SlaveSlot_0.eraseSize)
+
+/* Worst case times of the memory operations */
+#define SMIF_MEM_ERASE_TIME_MS      (deviceCfg_S25FL512S_4byteaddr_SlaveSlot_0.eraseTime)
+#define SMIF_MEM_PROGRAM_TIME_US    (deviceCfg_S25FL512S_4byteaddr_SlaveSlot_0.programTime)
+
+/* Timeout for SMIF block operations (in microseconds) */
+#define SMIF_MEM_TIMEOUT_US         10000u
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const SysPmRegistryTable smifMemSysPmTable;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_smif_status_t SmifMem_Init(void);
+bool SmifMem_IsBusy(void);
+bool SmifMem_IsErasing(void);
+bool SmifMem_FinishProgram(void);
+cy_en_smif_status_t SmifMem_EraseSector(uint32_t offset);
+cy_en_smif_status_t SmifMem_ProgramPage(uint32_t offset, const uint8_t *data);
+const uint8_t *SmifMem_GetMappedAddress(uint32_t offset);
+bool SmifMem_Suspend(void);
+void SmifMem_Resume(void);
+void SmifMem_InterruptHandler(void);
+
+cy_en_syspm_status_t SmifMem_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SMIF_MEM_H */
+
+/* [] END OF FILE */
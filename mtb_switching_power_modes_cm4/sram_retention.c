@@ -0,0 +1,196 @@
+/***************************************************************************//**
+* \file sram_retention.c
+* \version 1.0
+*
+* \brief
+* Power-down of the unused SRAM macros in System Deep Sleep. See
+* sram_retention.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "app_sections.h"
+#include "sram_retention.h"
+
+
+#if defined(SRAM_RETENTION)
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* SysPm callbacks */
+static const SysPmRegistryEntry sramRetentionSysPmEntries[] =
+{
+    { SramRetention_DeepSleepCallback, CY_SYSPM_DEEPSLEEP,
+      SYSPM_PHASE_BEFORE_TRANSITION | SYSPM_PHASE_AFTER_TRANSITION, SYSPM_PRIORITY_PERIPHERAL },
+};
+
+const SysPmRegistryTable sramRetentionSysPmTable =
+{
+    sramRetentionSysPmEntries, sizeof(sramRetentionSysPmEntries) / sizeof(sramRetentionSysPmEntries[0])
+};
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Bounds of the unused RAM, from the linker script */
+extern uint32_t __HeapBase[];
+extern uint32_t __StackLimit[];
+
+/* RAMC0 macros switched off in Deep Sleep: [first, last) */
+static uint32_t sramRetentionFirst = 0u;
+static uint32_t sramRetentionLast = 0u;
+
+/* RAMC1 and RAMC2 switched off in Deep Sleep */
+static bool sramRetentionRamc1 = false;
+static bool sramRetentionRamc2 = false;
+
+
+/*******************************************************************************
+* Function Name: SramRetention_SetMode
+****************************************************************************//**
+*
+* Sets the power mode of the unused macros and controllers.
+*
+*******************************************************************************/
+static APP_HOT void SramRetention_SetMode(uint32_t pwrMode)
+{
+    uint32_t macro;
+
+    for (macro = sramRetentionFirst; macro < sramRetentionLast; macro++)
+    {
+        CPUSS->RAM0_PWR_MACRO_CTL[macro] =
+            _VAL2FLD(CPUSS_RAM0_PWR_MACRO_CTL_VECTKEYSTAT, SRAM_RETENTION_WRITE_KEY) |
+            _VAL2FLD(CPUSS_RAM0_PWR_MACRO_CTL_PWR_MODE, pwrMode);
+    }
+
+    if (sramRetentionRamc1)
+    {
+        CPUSS->RAM1_PWR_CTL =
+            _VAL2FLD(CPUSS_RAM1_PWR_CTL_VECTKEYSTAT, SRAM_RETENTION_WRITE_KEY) |
+            _VAL2FLD(CPUSS_RAM1_PWR_CTL_PWR_MODE, pwrMode);
+    }
+
+    if (sramRetentionRamc2)
+    {
+        CPUSS->RAM2_PWR_CTL =
+            _VAL2FLD(CPUSS_RAM2_PWR_CTL_VECTKEYSTAT, SRAM_RETENTION_WRITE_KEY) |
+            _VAL2FLD(CPUSS_RAM2_PWR_CTL_PWR_MODE, pwrMode);
+    }
+}
+
+/*******************************************************************************
+* Function Name: SramRetention_IsUnused
+****************************************************************************//**
+*
+* Returns true if [base, base + size) lies entirely between the end of
+* .noinit and the bottom of the stack.
+*
+*******************************************************************************/
+static bool SramRetention_IsUnused(uint32_t base, uint32_t size)
+{
+    return (base >= (uint32_t)__HeapBase) && ((base + size) <= (uint32_t)__StackLimit);
+}
+
+/*******************************************************************************
+* Function Name: SramRetention_Init
+****************************************************************************//**
+*
+* Finds the RAMC0 macros, and the RAMC1 and RAMC2 controllers, that lie
+* entirely between the end of .noinit and the bottom of the stack.
+*
+*******************************************************************************/
+void SramRetention_Init(void)
+{
+    uint32_t first = ((uint32_t)__HeapBase - CY_SRAM_BASE + SRAM_RETENTION_MACRO_SIZE - 1u) / SRAM_RETENTION_MACRO_SIZE;
+    uint32_t last = ((uint32_t)__StackLimit - CY_SRAM_BASE) / SRAM_RETENTION_MACRO_SIZE;
+
+    /* RAMC1 and RAMC2 are not made of RAMC0 macros */
+    if (last > SRAM_RETENTION_MACRO_COUNT)
+    {
+        last = SRAM_RETENTION_MACRO_COUNT;
+    }
+    if (first > last)
+    {
+        first = last;
+    }
+
+    /* Nothing in use may be switched off */
+    CY_ASSERT((first == last) || ((CY_SRAM_BASE + (first * SRAM_RETENTION_MACRO_SIZE)) >= (uint32_t)__HeapBase));
+
+    sramRetentionFirst = first;
+    sramRetentionLast = last;
+    sramRetentionRamc1 = SramRetention_IsUnused(SRAM_RETENTION_RAMC1_BASE, SRAM_RETENTION_RAMC1_SIZE);
+    sramRetentionRamc2 = SramRetention_IsUnused(SRAM_RETENTION_RAMC2_BASE, SRAM_RETENTION_RAMC2_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: SramRetention_GetRetainedSize
+****************************************************************************//**
+*
+* Returns the SRAM retained in Deep Sleep, in bytes.
+*
+*******************************************************************************/
+uint32_t SramRetention_GetRetainedSize(void)
+{
+    uint32_t size = CY_SRAM_SIZE - ((sramRetentionLast - sramRetentionFirst) * SRAM_RETENTION_MACRO_SIZE);
+
+    if (sramRetentionRamc1)
+    {
+        size -= SRAM_RETENTION_RAMC1_SIZE;
+    }
+    if (sramRetentionRamc2)
+    {
+        size -= SRAM_RETENTION_RAMC2_SIZE;
+    }
+
+    return size;
+}
+
+/*******************************************************************************
+* Function Name: SramRetention_DeepSleepCallback
+****************************************************************************//**
+*
+* Deep Sleep callback implementation. Before the transition it switches the
+* unused macros off. After the transition it switches them back on; their
+* content is undefined.
+*
+*******************************************************************************/
+APP_HOT cy_en_syspm_status_t SramRetention_DeepSleepCallback(
+    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t retVal = CY_SYSPM_FAIL;
+
+    switch (mode)
+    {
+        case CY_SYSPM_BEFORE_TRANSITION:
+            SramRetention_SetMode(SRAM_RETENTION_PWR_OFF);
+
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            SramRetention_SetMode(SRAM_RETENTION_PWR_ON);
+
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+
+        default:
+            /* Don't do anything in the other modes */
+            retVal = CY_SYSPM_SUCCESS;
+            break;
+    }
+
+    return retVal;
+}
+
+#endif /* defined(SRAM_RETENTION) */
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/***************************************************************************//**
+* \file sram_retention.h
+* \version 1.0
+*
+* \brief
+* Power-down of the unused SRAM macros in System Deep Sleep.
+*
+* By default every SRAM0 macro is retained in System Deep Sleep, and each one
+* adds its retention current. The BSP linker script already packs the
+* retained state at the bottom of SRAM: the CM0+ RAM, then the CM4 vectors,
+* .data (with the APP_HOT code), .bss and .noinit, where the telemetry
+* counters, the time base and the power mode live. The CM4 stack is at the
+* top of SRAM. The heap in between is not used by the application.
+*
+* The SRAM has three controllers: RAMC0 with CPUSS_RAMC0_MACRO_NR macros of
+* 32 KB, each with its own power control, then RAMC1 and RAMC2, each powered
+* as a whole. SramRetention_Init() takes the bounds from the linker symbols:
+* the RAMC0 macros, and RAMC1 or RAMC2, that lie entirely between __HeapBase
+* and __StackLimit are unused. The stack is in RAMC2, so usually RAMC1 is
+* switched off with the top RAMC0 macros. The Deep Sleep callback switches
+* them off before the transition and back on after it, so they are neither
+* retained nor leaking in Deep Sleep.
+*
+* Re-initialization rules: a macro that was off comes back with undefined
+* content. Nothing is kept there, so nothing is restored on wake-up, but it
+* also means that nothing may be allocated from the heap across a Deep Sleep
+* transition. Build with SRAM_RETENTION=0 to retain the whole SRAM.
+*
+* The module is only built with SRAM_RETENTION=1 (the default).
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(SRAM_RETENTION_H)
+#define SRAM_RETENTION_H
+
+#include "cy_pdl.h"
+#include "syspm_registry.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* SRAM controllers of the CY8C624A, in address order from CY_SRAM_BASE */
+#define SRAM_RETENTION_RAMC0_SIZE   0x00080000u
+#define SRAM_RETENTION_RAMC1_BASE   (CY_SRAM_BASE + SRAM_RETENTION_RAMC0_SIZE)
+#define SRAM_RETENTION_RAMC1_SIZE   0x00040000u
+#define SRAM_RETENTION_RAMC2_BASE   (SRAM_RETENTION_RAMC1_BASE + SRAM_RETENTION_RAMC1_SIZE)
+#define SRAM_RETENTION_RAMC2_SIZE   0x00040000u
+
+/* RAMC0 macros */
+#define SRAM_RETENTION_MACRO_COUNT  CPUSS_RAMC0_MACRO_NR
+#define SRAM_RETENTION_MACRO_SIZE   (SRAM_RETENTION_RAMC0_SIZE / CPUSS_RAMC0_MACRO_NR)
+
+/* RAMx_PWR_CTL write key and power modes */
+#define SRAM_RETENTION_WRITE_KEY    0x05FAu
+#define SRAM_RETENTION_PWR_OFF      0u
+#define SRAM_RETENTION_PWR_ON       3u
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const SysPmRegistryTable sramRetentionSysPmTable;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void SramRetention_Init(void);
+uint32_t SramRetention_GetRetainedSize(void);
+
+cy_en_syspm_status_t SramRetention_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SRAM_RETENTION_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/***************************************************************************//**
+* \file syspm_registry.c
+* \version 1.0
+*
+* \brief
+* Static registry of the SysPm callbacks. See syspm_registry.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "syspm_registry.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* The PDL links the callback objects into its lists, they must stay valid */
+static cy_stc_syspm_callback_t sysPmCallbacks[SYSPM_REGISTRY_MAX_CALLBACKS];
+static uint32_t sysPmCallbackCount = 0u;
+
+/* None of the callbacks use the parameters */
+static cy_stc_syspm_callback_params_t sysPmCallbackParams = {
+    /*.base       =*/ NULL,
+    /*.context    =*/ NULL
+};
+
+
+/*******************************************************************************
+* Function Name: SysPmRegistry_Init
+****************************************************************************//**
+*
+* Registers the callbacks of all tables with the PDL, in ascending priority
+* and, for equal priorities, in the order of the tables and their entries.
+* Entries without phases are left out. Call once, before the first power mode
+* transition.
+*
+*******************************************************************************/
+void SysPmRegistry_Init(const SysPmRegistryTable *const tables[], uint32_t tableCount)
+{
+    const SysPmRegistryEntry *order[SYSPM_REGISTRY_MAX_CALLBACKS];
+    const SysPmRegistryEntry *entry;
+    uint32_t count = 0u;
+    uint32_t t;
+    uint32_t i;
+    uint32_t j;
+
+    /* Collect the entries, keeping them sorted (stable insertion sort) */
+    for (t = 0u; t < tableCount; t++)
+    {
+        for (i = 0u; i < tables[t]->count; i++)
+        {
+            entry = &tables[t]->entries[i];
+            if (0u == (entry->phases & SYSPM_PHASE_ALL))
+            {
+                continue;
+            }
+
+            CY_ASSERT(count < SYSPM_REGISTRY_MAX_CALLBACKS);
+
+            for (j = count; (j > 0u) && (order[j - 1u]->priority > entry->priority); j--)
+            {
+                order[j] = order[j - 1u];
+            }
+            order[j] = entry;
+            count++;
+        }
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        sysPmCallbacks[i].callback = order[i]->callback;
+        sysPmCallbacks[i].type = order[i]->type;
+        sysPmCallbacks[i].skipMode = SYSPM_PHASE_ALL & ~(uint32_t)order[i]->phases;
+        sysPmCallbacks[i].callbackParams = &sysPmCallbackParams;
+        sysPmCallbacks[i].prevItm = NULL;
+        sysPmCallbacks[i].nextItm = NULL;
+
+        if (!Cy_SysPm_RegisterCallback(&sysPmCallbacks[i]))
+        {
+            CY_ASSERT(0);
+        }
+    }
+
+    sysPmCallbackCount = count;
+}
+
+/*******************************************************************************
+* Function Name: SysPmRegistry_GetCount
+****************************************************************************//**
+*
+* Returns the number of callbacks registered for a transition type.
+*
+*******************************************************************************/
+uint32_t SysPmRegistry_GetCount(cy_en_syspm_callback_type_t type)
+{
+    uint32_t count = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < sysPmCallbackCount; i++)
+    {
+        if (type == sysPmCallbacks[i].type)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/***************************************************************************//**
+* \file syspm_registry.h
+* \version 1.0
+*
+* \brief
+* Static registry of the SysPm callbacks.
+*
+* Each subsystem declares its callbacks in a const table: the function, the
+* transition type, the phases it implements and a priority. The skip mask
+* handed to the PDL is derived from the phases, so a callback is never called
+* for a phase it does nothing in, and a callback without phases is not
+* registered at all. The callbacks are registered in ascending priority (table
+* order for equal priorities): the PDL runs them in that order for
+* CY_SYSPM_CHECK_READY and CY_SYSPM_BEFORE_TRANSITION, and in reverse order for
+* CY_SYSPM_CHECK_FAIL and CY_SYSPM_AFTER_TRANSITION.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(SYSPM_REGISTRY_H)
+#define SYSPM_REGISTRY_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Phases a callback implements, on the bits of the matching skip flags */
+#define SYSPM_PHASE_CHECK_READY         CY_SYSPM_SKIP_CHECK_READY
+#define SYSPM_PHASE_CHECK_FAIL          CY_SYSPM_SKIP_CHECK_FAIL
+#define SYSPM_PHASE_BEFORE_TRANSITION   CY_SYSPM_SKIP_BEFORE_TRANSITION
+#define SYSPM_PHASE_AFTER_TRANSITION    CY_SYSPM_SKIP_AFTER_TRANSITION
+#define SYSPM_PHASE_ALL                 (SYSPM_PHASE_CHECK_READY | SYSPM_PHASE_CHECK_FAIL | \
+                                         SYSPM_PHASE_BEFORE_TRANSITION | SYSPM_PHASE_AFTER_TRANSITION)
+
+/* Priorities, lowest first before the transition and last after it */
+#define SYSPM_PRIORITY_QOS              0u      /* Vetoes, before any change */
+#define SYSPM_PRIORITY_PERIPHERAL       64u     /* Peripherals and their memories */
+#define SYSPM_PRIORITY_CLOCK            128u    /* CLK_HF0 frequency */
+#define SYSPM_PRIORITY_CLOCK_ROOT       192u    /* Clock roots of the peripherals */
+
+/* Most callbacks the registry holds */
+#define SYSPM_REGISTRY_MAX_CALLBACKS    24u
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    Cy_SysPmCallback callback;
+    cy_en_syspm_callback_type_t type;
+    uint8_t phases;         /* SYSPM_PHASE_* the callback implements */
+    uint8_t priority;       /* SYSPM_PRIORITY_* */
+} SysPmRegistryEntry;
+
+/* The callbacks of one subsystem */
+typedef struct
+{
+    const SysPmRegistryEntry *entries;
+    uint32_t count;
+} SysPmRegistryTable;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void SysPmRegistry_Init(const SysPmRegistryTable *const tables[], uint32_t tableCount);
+uint32_t SysPmRegistry_GetCount(cy_en_syspm_callback_type_t type);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SYSPM_REGISTRY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,296 @@
+/***************************************************************************//**
+* \file telemetry_codec.c
+* \version 1.0
+*
+* \brief
+* Compact encoding of telemetry records. See telemetry_codec.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "telemetry_codec.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define TELEMETRY_CODEC_VARINT_MAX  10u
+
+
+/*******************************************************************************
+* Function Name: TelemetryCodec_PutVarint
+****************************************************************************//**
+*
+* Writes value as an unsigned LEB128 varint and returns the number of bytes
+* written (1 to 10).
+*
+*******************************************************************************/
+size_t TelemetryCodec_PutVarint(uint8_t *dst, uint64_t value)
+{
+    size_t n = 0u;
+
+    while (value >= 0x80u)
+    {
+        dst[n++] = (uint8_t)(value | 0x80u);
+        value >>= 7u;
+    }
+    dst[n++] = (uint8_t)value;
+
+    return n;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryCodec_GetVarint
+****************************************************************************//**
+*
+* Reads an unsigned LEB128 varint of at most length bytes. Returns the number
+* of bytes read, or 0 if the varint is truncated or too long.
+*
+*******************************************************************************/
+size_t TelemetryCodec_GetVarint(const uint8_t *src, size_t length, uint64_t *value)
+{
+    uint64_t result = 0u;
+    uint32_t shift = 0u;
+    size_t n = 0u;
+
+    while ((n < length) && (n < TELEMETRY_CODEC_VARINT_MAX))
+    {
+        result |= (uint64_t)(src[n] & 0x7Fu) << shift;
+        if (0u == (src[n++] & 0x80u))
+        {
+            *value = result;
+            return n;
+        }
+        shift += 7u;
+    }
+
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryCodec_Reset
+****************************************************************************//**
+*
+* Resets the codec state at the start of a page.
+*
+*******************************************************************************/
+void TelemetryCodec_Reset(TelemetryCodecState *state, uint64_t baseTime)
+{
+    state->prevTime = baseTime;
+    state->token1 = TELEMETRY_CODEC_NO_TOKEN;
+    state->token2 = TELEMETRY_CODEC_NO_TOKEN;
+    state->runPos = 0u;
+    state->runLeft = 0u;
+    state->runOpen = false;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryCodec_Encode
+****************************************************************************//**
+*
+* Appends a record to buf, which already holds used bytes out of size. Returns
+* the number of bytes appended, or 0 (with buf and state unchanged) if the
+* record does not fit.
+*
+*******************************************************************************/
+size_t TelemetryCodec_Encode(TelemetryCodecState *state, uint8_t *buf, size_t used, size_t size,
+                             const TelemetryRecord *record)
+{
+    uint8_t item[TELEMETRY_CODEC_MAX_RECORD_SIZE];
+    uint16_t token;
+    uint64_t delta;
+    int64_t diff;
+    bool repeat;
+    bool extend;
+    size_t n = 0u;
+
+    token = (uint16_t)((((uint32_t)record->kind & 0x03u) << TELEMETRY_CODEC_KIND_POS) |
+                       (((uint32_t)record->from & TELEMETRY_CODEC_MODE_MASK) << TELEMETRY_CODEC_FROM_POS) |
+                       ((uint32_t)record->to & TELEMETRY_CODEC_MODE_MASK));
+    delta = record->time - state->prevTime;
+    diff = (int64_t)record->residency - (int64_t)delta;
+
+    repeat = (TELEMETRY_CODEC_NO_TOKEN != state->token2) && (token == state->token2);
+    extend = repeat && state->runOpen &&
+             ((buf[state->runPos] & 0x3Fu) < (TELEMETRY_CODEC_RUN_MAX - 1u));
+
+    if (!extend)
+    {
+        /* A new run starts with a count of one */
+        item[n++] = repeat ? (uint8_t)(TELEMETRY_CODEC_KIND_RUN << TELEMETRY_CODEC_KIND_POS) : (uint8_t)token;
+    }
+    n += TelemetryCodec_PutVarint(&item[n], delta);
+    n += TelemetryCodec_PutVarint(&item[n], ((uint64_t)diff << 1u) ^ (uint64_t)(diff >> 63u));
+
+    if ((used + n) > size)
+    {
+        return 0u;
+    }
+
+    (void)memcpy(&buf[used], item, n);
+
+    if (extend)
+    {
+        buf[state->runPos]++;
+    }
+    else if (repeat)
+    {
+        state->runPos = (uint16_t)used;
+        state->runOpen = true;
+    }
+    else
+    {
+        state->runOpen = false;
+    }
+
+    state->prevTime = record->time;
+    state->token2 = state->token1;
+    state->token1 = token;
+
+    return n;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryCodec_Decode
+****************************************************************************//**
+*
+* Decodes the next record from src, which holds length bytes. Returns the
+* number of bytes consumed, or 0 at the end of the data or on a format error.
+*
+*******************************************************************************/
+size_t TelemetryCodec_Decode(TelemetryCodecState *state, const uint8_t *src, size_t length,
+                             TelemetryRecord *record)
+{
+    uint64_t delta;
+    uint64_t zigzag;
+    uint16_t token;
+    size_t n = 0u;
+    size_t m;
+
+    if ((0u == state->runLeft) && (0u != length) &&
+        (TELEMETRY_CODEC_KIND_RUN == (src[0] >> TELEMETRY_CODEC_KIND_POS)))
+    {
+        if (TELEMETRY_CODEC_NO_TOKEN == state->token2)
+        {
+            return 0u;
+        }
+        state->runLeft = (uint8_t)((src[n++] & 0x3Fu) + 1u);
+    }
+
+    if (0u != state->runLeft)
+    {
+        token = state->token2;
+    }
+    else if (n < length)
+    {
+        token = src[n++];
+    }
+    else
+    {
+        return 0u;
+    }
+
+    m = TelemetryCodec_GetVarint(&src[n], length - n, &delta);
+    if (0u == m)
+    {
+        return 0u;
+    }
+    n += m;
+
+    m = TelemetryCodec_GetVarint(&src[n], length - n, &zigzag);
+    if (0u == m)
+    {
+        return 0u;
+    }
+    n += m;
+
+    if (0u != state->runLeft)
+    {
+        state->runLeft--;
+    }
+
+    record->time = state->prevTime + delta;
+    record->kind = (uint8_t)(token >> TELEMETRY_CODEC_KIND_POS);
+    record->from = (uint8_t)((token >> TELEMETRY_CODEC_FROM_POS) & TELEMETRY_CODEC_MODE_MASK);
+    record->to = (uint8_t)(token & TELEMETRY_CODEC_MODE_MASK);
+    record->residency = (uint32_t)((int64_t)delta + ((int64_t)(zigzag >> 1u) ^ -(int64_t)(zigzag & 1u)));
+
+    state->prevTime = record->time;
+    state->token2 = state->token1;
+    state->token1 = token;
+
+    return n;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryCodec_OpenPage
+****************************************************************************//**
+*
+* Prepares reader to iterate over the records of a page whose header has been
+* validated with TelemetryFormat_ReadHeader().
+*
+*******************************************************************************/
+void TelemetryCodec_OpenPage(TelemetryPageReader *reader, const uint8_t *page,
+                             const TelemetryPageHeader *header)
+{
+    reader->payload = &page[TELEMETRY_HEADER_SIZE];
+    reader->length = header->length;
+    reader->pos = 0u;
+    reader->baseTime = header->baseTime;
+    reader->format = header->format;
+    reader->left = header->count;
+    TelemetryCodec_Reset(&reader->codec, header->baseTime);
+}
+
+/*******************************************************************************
+* Function Name: TelemetryCodec_NextRecord
+****************************************************************************//**
+*
+* Reads the next record of the page. Returns false after the last record, on
+* a format error or for an unknown page format.
+*
+*******************************************************************************/
+bool TelemetryCodec_NextRecord(TelemetryPageReader *reader, TelemetryRecord *record)
+{
+    size_t n = 0u;
+
+    if (0u == reader->left)
+    {
+        return false;
+    }
+
+    if (TELEMETRY_PAGE_FORMAT_PACKED == reader->format)
+    {
+        n = TelemetryCodec_Decode(&reader->codec, &reader->payload[reader->pos],
+                                  reader->length - reader->pos, record);
+    }
+    else if ((TELEMETRY_PAGE_FORMAT_RAW == reader->format) &&
+             ((reader->pos + TELEMETRY_RAW_RECORD_SIZE) <= reader->length))
+    {
+        TelemetryFormat_GetRawRecord(&reader->payload[reader->pos], record, reader->baseTime);
+        n = TELEMETRY_RAW_RECORD_SIZE;
+    }
+    else
+    {
+        /* Unknown format or truncated payload */
+    }
+
+    if (0u == n)
+    {
+        reader->left = 0u;
+        return false;
+    }
+
+    reader->pos += n;
+    reader->left--;
+
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,104 @@
+/***************************************************************************//**
+* \file telemetry_codec.h
+* \version 1.0
+*
+* \brief
+* Compact (TELEMETRY_PAGE_FORMAT_PACKED) encoding of telemetry records.
+*
+* Each record is a token byte followed by two LEB128 varints:
+* - token: kind (bits 7:6), mode left (bits 5:3), mode entered (bits 2:0)
+* - time delta from the previous record of the page (the page base time for
+*   the first record)
+* - residency, zigzag-coded as the difference from the time delta. For a
+*   transition the residency normally equals the delta, so this is one byte.
+*
+* Mode changes usually alternate between two modes. A run token (kind 3,
+* bits 5:0 = count - 1) announces that the next count records repeat the
+* token of the record two positions earlier; those records carry only the two
+* varints. The encoder extends the last run token in place, so records can be
+* appended one at a time. The codec state is reset at every page, so each
+* page decodes on its own.
+*
+* This file has no PDL dependencies, so the host tools can share it.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(TELEMETRY_CODEC_H)
+#define TELEMETRY_CODEC_H
+
+#include "telemetry_format.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Largest encoded record: token + two 10-byte varints */
+#define TELEMETRY_CODEC_MAX_RECORD_SIZE 21u
+
+/* Token layout */
+#define TELEMETRY_CODEC_KIND_POS        6u
+#define TELEMETRY_CODEC_FROM_POS        3u
+#define TELEMETRY_CODEC_MODE_MASK       0x07u
+#define TELEMETRY_CODEC_KIND_RUN        3u
+#define TELEMETRY_CODEC_RUN_MAX         64u
+
+/* No token seen yet */
+#define TELEMETRY_CODEC_NO_TOKEN        0xFFFFu
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint64_t prevTime;      /* Time of the previous record */
+    uint16_t token1;        /* Token of the previous record */
+    uint16_t token2;        /* Token of the record before that */
+    uint16_t runPos;        /* Encoder: offset of the open run token */
+    uint8_t  runLeft;       /* Decoder: records left in the current run */
+    bool     runOpen;       /* Encoder: the last item written is a run */
+} TelemetryCodecState;
+
+/* Iterates over the records of a valid page, in either format */
+typedef struct
+{
+    const uint8_t *payload;
+    size_t   length;
+    size_t   pos;
+    uint64_t baseTime;
+    uint8_t  format;
+    uint8_t  left;          /* Records left to read */
+    TelemetryCodecState codec;
+} TelemetryPageReader;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void TelemetryCodec_Reset(TelemetryCodecState *state, uint64_t baseTime);
+size_t TelemetryCodec_Encode(TelemetryCodecState *state, uint8_t *buf, size_t used, size_t size,
+                             const TelemetryRecord *record);
+size_t TelemetryCodec_Decode(TelemetryCodecState *state, const uint8_t *src, size_t length,
+                             TelemetryRecord *record);
+
+void TelemetryCodec_OpenPage(TelemetryPageReader *reader, const uint8_t *page,
+                             const TelemetryPageHeader *header);
+bool TelemetryCodec_NextRecord(TelemetryPageReader *reader, TelemetryRecord *record);
+
+size_t TelemetryCodec_PutVarint(uint8_t *dst, uint64_t value);
+size_t TelemetryCodec_GetVarint(const uint8_t *src, size_t length, uint64_t *value);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TELEMETRY_CODEC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,225 @@
+/***************************************************************************//**
+* \file telemetry_format.c
+* \version 1.0
+*
+* \brief
+* On-flash layout of the power-mode telemetry log. See telemetry_format.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "telemetry_format.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Reflected CRC-32 (IEEE 802.3) polynomial */
+#define TELEMETRY_CRC32_POLY        0xEDB88320u
+
+/* Header field offsets */
+#define TELEMETRY_HDR_MAGIC         0u
+#define TELEMETRY_HDR_SEQ           4u
+#define TELEMETRY_HDR_BASE_TIME     8u
+#define TELEMETRY_HDR_LENGTH        16u
+#define TELEMETRY_HDR_FORMAT        18u
+#define TELEMETRY_HDR_COUNT         19u
+
+/* Raw record field offsets */
+#define TELEMETRY_RAW_TIME          0u
+#define TELEMETRY_RAW_KIND          4u
+#define TELEMETRY_RAW_FROM          5u
+#define TELEMETRY_RAW_TO            6u
+#define TELEMETRY_RAW_RESIDENCY     8u
+
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_Crc32
+****************************************************************************//**
+*
+* Updates a CRC-32 with length bytes of data. Start with crc = 0.
+*
+*******************************************************************************/
+uint32_t TelemetryFormat_Crc32(uint32_t crc, const uint8_t *data, size_t length)
+{
+    uint32_t bit;
+
+    crc = ~crc;
+    while (0u != length)
+    {
+        crc ^= *data;
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (crc >> 1u) ^ (TELEMETRY_CRC32_POLY & (0u - (crc & 1u)));
+        }
+        data++;
+        length--;
+    }
+
+    return ~crc;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_PutU16
+****************************************************************************//**
+*
+* Stores a 16-bit value in little-endian order.
+*
+*******************************************************************************/
+void TelemetryFormat_PutU16(uint8_t *dst, uint16_t value)
+{
+    dst[0] = (uint8_t)(value);
+    dst[1] = (uint8_t)(value >> 8u);
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_PutU32
+****************************************************************************//**
+*
+* Stores a 32-bit value in little-endian order.
+*
+*******************************************************************************/
+void TelemetryFormat_PutU32(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t)(value);
+    dst[1] = (uint8_t)(value >> 8u);
+    dst[2] = (uint8_t)(value >> 16u);
+    dst[3] = (uint8_t)(value >> 24u);
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_GetU16
+****************************************************************************//**
+*
+* Loads a little-endian 16-bit value.
+*
+*******************************************************************************/
+uint16_t TelemetryFormat_GetU16(const uint8_t *src)
+{
+    return (uint16_t)((uint16_t)src[0] | ((uint16_t)src[1] << 8u));
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_GetU32
+****************************************************************************//**
+*
+* Loads a little-endian 32-bit value.
+*
+*******************************************************************************/
+uint32_t TelemetryFormat_GetU32(const uint8_t *src)
+{
+    return ((uint32_t)src[0]) | ((uint32_t)src[1] << 8u) |
+           ((uint32_t)src[2] << 16u) | ((uint32_t)src[3] << 24u);
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_SealPage
+****************************************************************************//**
+*
+* Writes the header to the start of a page buffer whose payload is already in
+* place, and computes the CRC. The crc field of header is ignored.
+*
+*******************************************************************************/
+void TelemetryFormat_SealPage(uint8_t *page, const TelemetryPageHeader *header)
+{
+    uint32_t crc;
+
+    TelemetryFormat_PutU32(&page[TELEMETRY_HDR_MAGIC], header->magic);
+    TelemetryFormat_PutU32(&page[TELEMETRY_HDR_SEQ], header->seq);
+    TelemetryFormat_PutU32(&page[TELEMETRY_HDR_BASE_TIME], (uint32_t)header->baseTime);
+    TelemetryFormat_PutU32(&page[TELEMETRY_HDR_BASE_TIME + 4u], (uint32_t)(header->baseTime >> 32u));
+    TelemetryFormat_PutU16(&page[TELEMETRY_HDR_LENGTH], header->length);
+    page[TELEMETRY_HDR_FORMAT] = header->format;
+    page[TELEMETRY_HDR_COUNT] = header->count;
+
+    crc = TelemetryFormat_Crc32(0u, page, TELEMETRY_HEADER_CRC_OFFSET);
+    crc = TelemetryFormat_Crc32(crc, &page[TELEMETRY_HEADER_SIZE], header->length);
+    TelemetryFormat_PutU32(&page[TELEMETRY_HEADER_CRC_OFFSET], crc);
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_ReadHeader
+****************************************************************************//**
+*
+* Decodes the header of a page. Returns true only if the magic, the length and
+* the CRC are all valid; header is filled in either way.
+*
+*******************************************************************************/
+bool TelemetryFormat_ReadHeader(const uint8_t *page, TelemetryPageHeader *header)
+{
+    uint32_t crc;
+
+    header->magic    = TelemetryFormat_GetU32(&page[TELEMETRY_HDR_MAGIC]);
+    header->seq      = TelemetryFormat_GetU32(&page[TELEMETRY_HDR_SEQ]);
+    header->baseTime = ((uint64_t)TelemetryFormat_GetU32(&page[TELEMETRY_HDR_BASE_TIME + 4u]) << 32u) |
+                       TelemetryFormat_GetU32(&page[TELEMETRY_HDR_BASE_TIME]);
+    header->length   = TelemetryFormat_GetU16(&page[TELEMETRY_HDR_LENGTH]);
+    header->format   = page[TELEMETRY_HDR_FORMAT];
+    header->count    = page[TELEMETRY_HDR_COUNT];
+    header->crc      = TelemetryFormat_GetU32(&page[TELEMETRY_HEADER_CRC_OFFSET]);
+
+    if ((TELEMETRY_PAGE_MAGIC != header->magic) || (header->length > TELEMETRY_PAYLOAD_SIZE))
+    {
+        return false;
+    }
+
+    crc = TelemetryFormat_Crc32(0u, page, TELEMETRY_HEADER_CRC_OFFSET);
+    crc = TelemetryFormat_Crc32(crc, &page[TELEMETRY_HEADER_SIZE], header->length);
+
+    return (crc == header->crc);
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_IsErased
+****************************************************************************//**
+*
+* Returns true if the page has never been programmed since the last erase.
+* Pages are programmed from the first byte on, so a torn page always has a
+* programmed magic field.
+*
+*******************************************************************************/
+bool TelemetryFormat_IsErased(const uint8_t *page)
+{
+    return (0xFFFFFFFFu == TelemetryFormat_GetU32(&page[TELEMETRY_HDR_MAGIC]));
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_PutRawRecord
+****************************************************************************//**
+*
+* Encodes a record in the raw format. The time is stored relative to the base
+* time of the page.
+*
+*******************************************************************************/
+void TelemetryFormat_PutRawRecord(uint8_t *dst, const TelemetryRecord *record, uint64_t baseTime)
+{
+    TelemetryFormat_PutU32(&dst[TELEMETRY_RAW_TIME], (uint32_t)(record->time - baseTime));
+    dst[TELEMETRY_RAW_KIND] = record->kind;
+    dst[TELEMETRY_RAW_FROM] = record->from;
+    dst[TELEMETRY_RAW_TO] = record->to;
+    dst[TELEMETRY_RAW_TO + 1u] = 0u;
+    TelemetryFormat_PutU32(&dst[TELEMETRY_RAW_RESIDENCY], record->residency);
+}
+
+/*******************************************************************************
+* Function Name: TelemetryFormat_GetRawRecord
+****************************************************************************//**
+*
+* Decodes a record in the raw format.
+*
+*******************************************************************************/
+void TelemetryFormat_GetRawRecord(const uint8_t *src, TelemetryRecord *record, uint64_t baseTime)
+{
+    record->time      = baseTime + TelemetryFormat_GetU32(&src[TELEMETRY_RAW_TIME]);
+    record->kind      = src[TELEMETRY_RAW_KIND];
+    record->from      = src[TELEMETRY_RAW_FROM];
+    record->to        = src[TELEMETRY_RAW_TO];
+    record->residency = TelemetryFormat_GetU32(&src[TELEMETRY_RAW_RESIDENCY]);
+}
+
+/* [] END OF FILE */
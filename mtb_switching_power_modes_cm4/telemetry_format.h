@@ -0,0 +1,137 @@
+/***************************************************************************//**
+* \file telemetry_format.h
+* \version 1.0
+*
+* \brief
+* On-flash layout of the power-mode telemetry log.
+*
+* The log is a ring of erase sectors, each holding a sequence of pages. Every
+* page is self-describing: a fixed header (magic, sequence number, base time,
+* payload format and length) followed by the payload, all covered by a CRC-32.
+* A page that fails the check (torn by a power loss) is skipped by readers.
+* All multi-byte fields are little-endian.
+*
+* This file has no PDL dependencies, so the host tools can share it.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(TELEMETRY_FORMAT_H)
+#define TELEMETRY_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Geometry of the log, matching the S25FL512S program and erase sizes */
+#define TELEMETRY_PAGE_SIZE             512u
+#define TELEMETRY_SECTOR_SIZE           0x40000u
+#define TELEMETRY_PAGES_PER_SECTOR      (TELEMETRY_SECTOR_SIZE / TELEMETRY_PAGE_SIZE)
+
+/* Log region: the last 4 MB of the 64 MB QSPI memory */
+#define TELEMETRY_FLASH_SIZE            0x04000000u
+#define TELEMETRY_LOG_OFFSET            0x03C00000u
+#define TELEMETRY_LOG_SECTORS           16u
+#define TELEMETRY_LOG_SIZE              (TELEMETRY_LOG_SECTORS * TELEMETRY_SECTOR_SIZE)
+
+/* Page header */
+#define TELEMETRY_PAGE_MAGIC            0x474F4C54u     /* "TLOG" */
+#define TELEMETRY_HEADER_SIZE           24u
+#define TELEMETRY_HEADER_CRC_OFFSET     20u
+#define TELEMETRY_PAYLOAD_SIZE          (TELEMETRY_PAGE_SIZE - TELEMETRY_HEADER_SIZE)
+
+/* Payload formats */
+#define TELEMETRY_PAGE_FORMAT_RAW       1u
+#define TELEMETRY_PAGE_FORMAT_PACKED    2u  /* See telemetry_codec.h */
+
+/* Raw record: time offset (4), kind (1), from (1), to (1), reserved (1),
+ * residency (4) */
+#define TELEMETRY_RAW_RECORD_SIZE       12u
+#define TELEMETRY_RAW_RECORDS_PER_PAGE  (TELEMETRY_PAYLOAD_SIZE / TELEMETRY_RAW_RECORD_SIZE)
+
+/* Record kinds */
+typedef enum
+{
+    TELEMETRY_REC_BOOT          = 0u,   /* Device reset, log resumed */
+    TELEMETRY_REC_TRANSITION    = 1u,   /* Power mode transition */
+    TELEMETRY_REC_STACK         = 2u,   /* New stack high-water mark of a core */
+} TelemetryRecordKind;
+
+/* Cores of a stack record */
+typedef enum
+{
+    TELEMETRY_CORE_CM0P         = 0u,
+    TELEMETRY_CORE_CM4          = 1u,
+    TELEMETRY_CORE_COUNT        = 2u,
+} TelemetryCore;
+
+/* Power modes */
+typedef enum
+{
+    TELEMETRY_MODE_LP_ACTIVE    = 0u,
+    TELEMETRY_MODE_ULP_ACTIVE   = 1u,
+    TELEMETRY_MODE_LP_SLEEP     = 2u,
+    TELEMETRY_MODE_ULP_SLEEP    = 3u,
+    TELEMETRY_MODE_DEEP_SLEEP   = 4u,
+    TELEMETRY_MODE_COUNT        = 5u,
+} TelemetryMode;
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;           /* Page sequence number, incremented per page */
+    uint64_t baseTime;      /* Log time of the first record (1/32768 s) */
+    uint16_t length;        /* Payload length in bytes */
+    uint8_t  format;        /* TELEMETRY_PAGE_FORMAT_* */
+    uint8_t  count;         /* Number of records in the payload */
+    uint32_t crc;           /* CRC-32 of the header (up to crc) and payload */
+} TelemetryPageHeader;
+
+typedef struct
+{
+    uint64_t time;          /* Log time (1/32768 s) */
+    uint8_t  kind;          /* TelemetryRecordKind */
+    uint8_t  from;          /* TelemetryMode left (TelemetryCore of a stack record) */
+    uint8_t  to;            /* TelemetryMode entered (0 in a stack record) */
+    uint32_t residency;     /* Ticks spent in the mode left (bytes of a stack record) */
+} TelemetryRecord;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t TelemetryFormat_Crc32(uint32_t crc, const uint8_t *data, size_t length);
+
+void TelemetryFormat_PutU16(uint8_t *dst, uint16_t value);
+void TelemetryFormat_PutU32(uint8_t *dst, uint32_t value);
+uint16_t TelemetryFormat_GetU16(const uint8_t *src);
+uint32_t TelemetryFormat_GetU32(const uint8_t *src);
+
+void TelemetryFormat_SealPage(uint8_t *page, const TelemetryPageHeader *header);
+bool TelemetryFormat_ReadHeader(const uint8_t *page, TelemetryPageHeader *header);
+bool TelemetryFormat_IsErased(const uint8_t *page);
+
+void TelemetryFormat_PutRawRecord(uint8_t *dst, const TelemetryRecord *record, uint64_t baseTime);
+void TelemetryFormat_GetRawRecord(const uint8_t *src, TelemetryRecord *record, uint64_t baseTime);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TELEMETRY_FORMAT_H */
+
+/* [] END OF FILE */
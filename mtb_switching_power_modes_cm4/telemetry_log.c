@@ -0,0 +1,618 @@
+/***************************************************************************//**
+* \file telemetry_log.c
+* \version 1.0
+*
+* \brief
+* Persistent, append-only log of power mode transitions and residency on the
+* external QSPI memory. See telemetry_log.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_pdl.h"
+#include "app_sections.h"
+#include "smif_mem.h"
+#include "pm_qos.h"
+#include "runtime_pm.h"
+#include "time_base.h"
+#include "telemetry_codec.h"
+#include "telemetry_log.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define TELEMETRY_LOG_NO_SECTOR     0xFFFFFFFFu
+
+/* Largest time offset of a raw record from the base time of its page */
+#define TELEMETRY_LOG_MAX_OFFSET    0xFFFFFFFFu
+
+/* RAM image of one page */
+typedef struct
+{
+    uint8_t  data[TELEMETRY_PAGE_SIZE];
+    uint64_t baseTime;
+    uint16_t length;
+    uint8_t  count;
+    TelemetryCodecState codec;
+} TelemetryLogBuffer;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static TelemetryLogBuffer logBuffers[TELEMETRY_LOG_BUFFERS];
+static uint32_t logProgIdx = 0u;        /* Oldest sealed buffer */
+static uint32_t logFullCount = 0u;      /* Sealed buffers waiting to be written */
+static bool logProgramming = false;
+static bool logFlashHeld = false;       /* Runtime PM reference on the SMIF */
+static PmQosRequest logClockRequest;    /* Held while pages wait to be written */
+
+/* Write position in the ring */
+static uint32_t logSeq = 0u;
+static uint32_t logSector = 0u;
+static uint32_t logPage = 0u;
+static bool logSectorErased = false;
+static uint32_t logReadySector = TELEMETRY_LOG_NO_SECTOR;
+static uint32_t logErasingSector = TELEMETRY_LOG_NO_SECTOR;
+
+/* Log time is the time base shifted to continue from the last logged record */
+static uint64_t logTimeOffset = 0u;
+
+static TelemetryMode logMode = TELEMETRY_MODE_LP_ACTIVE;
+static uint64_t logModeStart = 0u;
+static uint32_t logDropped = 0u;
+static uint32_t logStackHighWater[TELEMETRY_CORE_COUNT];   /* Last marks logged */
+static bool logReady = false;
+
+
+/*******************************************************************************
+* Function Name: TelemetryLog_GetTime
+****************************************************************************//**
+*
+* Returns the current log time in time base ticks.
+*
+*******************************************************************************/
+static uint64_t TelemetryLog_GetTime(void)
+{
+    return TimeBase_GetTicks() + logTimeOffset;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_PageOffset
+****************************************************************************//**
+*
+* Returns the offset in the QSPI memory of a page of the ring.
+*
+*******************************************************************************/
+static uint32_t TelemetryLog_PageOffset(uint32_t sector, uint32_t page)
+{
+    return TELEMETRY_LOG_OFFSET + (sector * TELEMETRY_SECTOR_SIZE) + (page * TELEMETRY_PAGE_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_NextSector
+****************************************************************************//**
+*
+* Returns the sector that follows sector in the ring.
+*
+*******************************************************************************/
+static uint32_t TelemetryLog_NextSector(uint32_t sector)
+{
+    return (sector + 1u) % TELEMETRY_LOG_SECTORS;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_FillBuffer
+****************************************************************************//**
+*
+* Returns the buffer that receives new records, or NULL if all buffers are
+* waiting to be written.
+*
+*******************************************************************************/
+static TelemetryLogBuffer *TelemetryLog_FillBuffer(void)
+{
+    if (TELEMETRY_LOG_BUFFERS == logFullCount)
+    {
+        return NULL;
+    }
+
+    return &logBuffers[(logProgIdx + logFullCount) % TELEMETRY_LOG_BUFFERS];
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_HoldClock
+****************************************************************************//**
+*
+* Holds the PM QoS minimum clock while sealed buffers wait to be written.
+*
+*******************************************************************************/
+static void TelemetryLog_HoldClock(void)
+{
+    if ((0u != logFullCount) && !logClockRequest.active)
+    {
+        PmQos_AddRequest(&logClockRequest, PM_QOS_MIN_CLOCK, TELEMETRY_LOG_MIN_CLOCK_MHZ);
+    }
+    else if ((0u == logFullCount) && logClockRequest.active)
+    {
+        PmQos_RemoveRequest(&logClockRequest);
+    }
+    else
+    {
+        /* No change */
+    }
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_Seal
+****************************************************************************//**
+*
+* Completes the header of the buffer being filled and queues it for writing.
+* The next buffer is cleared to the erased state.
+*
+*******************************************************************************/
+static void TelemetryLog_Seal(void)
+{
+    TelemetryLogBuffer *buf = TelemetryLog_FillBuffer();
+    TelemetryPageHeader header;
+
+    if ((NULL == buf) || (0u == buf->count))
+    {
+        return;
+    }
+
+    header.magic    = TELEMETRY_PAGE_MAGIC;
+    header.seq      = logSeq++;
+    header.baseTime = buf->baseTime;
+    header.length   = buf->length;
+    header.format   = TELEMETRY_LOG_FORMAT;
+    header.count    = buf->count;
+    TelemetryFormat_SealPage(buf->data, &header);
+
+    logFullCount++;
+    TelemetryLog_HoldClock();
+
+    buf = TelemetryLog_FillBuffer();
+    if (NULL != buf)
+    {
+        (void)memset(buf->data, 0xFF, sizeof(buf->data));
+        buf->length = 0u;
+        buf->count = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_Encode
+****************************************************************************//**
+*
+* Encodes a record at the end of a buffer. Returns false if it does not fit.
+* The first record of a buffer sets its base time.
+*
+*******************************************************************************/
+static bool TelemetryLog_Encode(TelemetryLogBuffer *buf, const TelemetryRecord *record)
+{
+    size_t n = 0u;
+
+    if (0u == buf->count)
+    {
+        buf->baseTime = record->time;
+        TelemetryCodec_Reset(&buf->codec, record->time);
+    }
+
+#if (TELEMETRY_PAGE_FORMAT_PACKED == TELEMETRY_LOG_FORMAT)
+    n = TelemetryCodec_Encode(&buf->codec, &buf->data[TELEMETRY_HEADER_SIZE], buf->length,
+                              TELEMETRY_PAYLOAD_SIZE, record);
+#else
+    if (((buf->length + TELEMETRY_RAW_RECORD_SIZE) <= TELEMETRY_PAYLOAD_SIZE) &&
+        ((record->time - buf->baseTime) <= TELEMETRY_LOG_MAX_OFFSET))
+    {
+        TelemetryFormat_PutRawRecord(&buf->data[TELEMETRY_HEADER_SIZE + buf->length], record, buf->baseTime);
+        n = TELEMETRY_RAW_RECORD_SIZE;
+    }
+#endif /* (TELEMETRY_PAGE_FORMAT_PACKED == TELEMETRY_LOG_FORMAT) */
+
+    if (0u == n)
+    {
+        return false;
+    }
+
+    buf->length += (uint16_t)n;
+    buf->count++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_Append
+****************************************************************************//**
+*
+* Adds a record to the buffer being filled. The record is dropped if no buffer
+* is free; this function never waits for the flash.
+*
+*******************************************************************************/
+static void TelemetryLog_Append(const TelemetryRecord *record)
+{
+    TelemetryLogBuffer *buf = TelemetryLog_FillBuffer();
+
+    /* Start a new page if the record does not fit in the current one */
+    if ((NULL != buf) && !TelemetryLog_Encode(buf, record))
+    {
+        TelemetryLog_Seal();
+        buf = TelemetryLog_FillBuffer();
+        if ((NULL != buf) && !TelemetryLog_Encode(buf, record))
+        {
+            buf = NULL;
+        }
+    }
+
+    if (NULL == buf)
+    {
+        logDropped++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_GetEndTime
+****************************************************************************//**
+*
+* Returns the time of the last record of a valid page.
+*
+*******************************************************************************/
+static APP_COLD uint64_t TelemetryLog_GetEndTime(const uint8_t *page, const TelemetryPageHeader *header)
+{
+    TelemetryPageReader reader;
+    TelemetryRecord record;
+    uint64_t endTime = header->baseTime;
+
+    TelemetryCodec_OpenPage(&reader, page, header);
+    while (TelemetryCodec_NextRecord(&reader, &record))
+    {
+        endTime = record.time;
+    }
+
+    return endTime;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_Recover
+****************************************************************************//**
+*
+* Finds the write position after a reset. The head sector is the one whose
+* first page has the highest sequence number. Pages are written in order, so
+* the first erased page of the head sector is found with a binary search.
+* Torn pages (failing the CRC) are skipped. Writing always resumes in a fresh
+* page, and at the start of a sector only after erasing it.
+*
+*******************************************************************************/
+static APP_COLD void TelemetryLog_Recover(void)
+{
+    TelemetryPageHeader header;
+    const uint8_t *page;
+    uint32_t sector;
+    uint32_t headSector = TELEMETRY_LOG_NO_SECTOR;
+    uint32_t headSeq = 0u;
+    uint32_t low;
+    uint32_t high;
+    uint32_t mid;
+    uint64_t endTime = 0u;
+
+    for (sector = 0u; sector < TELEMETRY_LOG_SECTORS; sector++)
+    {
+        page = SmifMem_GetMappedAddress(TelemetryLog_PageOffset(sector, 0u));
+        if (TelemetryFormat_ReadHeader(page, &header) &&
+            ((TELEMETRY_LOG_NO_SECTOR == headSector) || (header.seq > headSeq)))
+        {
+            headSector = sector;
+            headSeq = header.seq;
+        }
+    }
+
+    if (TELEMETRY_LOG_NO_SECTOR == headSector)
+    {
+        /* Empty log */
+        logSector = 0u;
+        logPage = 0u;
+        logSeq = 0u;
+        logSectorErased = false;
+        return;
+    }
+
+    /* First erased page of the head sector (page 0 is in use) */
+    low = 1u;
+    high = TELEMETRY_PAGES_PER_SECTOR;
+    while (low < high)
+    {
+        mid = low + ((high - low) / 2u);
+        page = SmifMem_GetMappedAddress(TelemetryLog_PageOffset(headSector, mid));
+        if (TelemetryFormat_IsErased(page))
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1u;
+        }
+    }
+
+    /* Last valid page before it */
+    logSeq = headSeq + 1u;
+    for (mid = low; mid > 0u; mid--)
+    {
+        page = SmifMem_GetMappedAddress(TelemetryLog_PageOffset(headSector, mid - 1u));
+        if (TelemetryFormat_ReadHeader(page, &header))
+        {
+            logSeq = header.seq + 1u;
+            endTime = TelemetryLog_GetEndTime(page, &header);
+            break;
+        }
+    }
+
+    if (TELEMETRY_PAGES_PER_SECTOR == low)
+    {
+        logSector = TelemetryLog_NextSector(headSector);
+        logPage = 0u;
+        logSectorErased = false;
+    }
+    else
+    {
+        logSector = headSector;
+        logPage = low;
+        logSectorErased = true;
+    }
+
+    /* Continue the log time after the last record */
+    logTimeOffset = (endTime + 1u) - TimeBase_GetTicks();
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_HoldFlash
+****************************************************************************//**
+*
+* Takes or drops the runtime PM reference on the QSPI memory, so that it is
+* powered up while an operation is outstanding and autosuspends otherwise.
+*
+*******************************************************************************/
+static void TelemetryLog_HoldFlash(bool hold)
+{
+    if (hold && !logFlashHeld)
+    {
+        RuntimePm_Get(RUNTIME_PM_DEV_SMIF);
+    }
+    else if (!hold && logFlashHeld)
+    {
+        RuntimePm_Put(RUNTIME_PM_DEV_SMIF);
+    }
+    else
+    {
+        /* No change */
+    }
+
+    logFlashHeld = hold;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_StartErase
+****************************************************************************//**
+*
+* Starts erasing a sector of the ring.
+*
+*******************************************************************************/
+static void TelemetryLog_StartErase(uint32_t sector)
+{
+    TelemetryLog_HoldFlash(true);
+    if (CY_SMIF_SUCCESS == SmifMem_EraseSector(TelemetryLog_PageOffset(sector, 0u)))
+    {
+        logErasingSector = sector;
+    }
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_Init
+****************************************************************************//**
+*
+* Recovers the write position of the log and records a boot event. Requires
+* SmifMem_Init(), TimeBase_Init() and RuntimePm_Init(). It is cold code, so
+* the caller holds RuntimePm_Get(RUNTIME_PM_DEV_SMIF) (see app_sections.h).
+* Returns false if the QSPI memory does not match the log geometry.
+*
+*******************************************************************************/
+APP_COLD bool TelemetryLog_Init(void)
+{
+    TelemetryRecord record;
+
+    if ((TELEMETRY_PAGE_SIZE != SMIF_MEM_PAGE_SIZE) ||
+        (TELEMETRY_SECTOR_SIZE != SMIF_MEM_SECTOR_SIZE) ||
+        ((TELEMETRY_LOG_OFFSET + TELEMETRY_LOG_SIZE) > SMIF_MEM_SIZE))
+    {
+        return false;
+    }
+
+    TelemetryLog_Recover();
+
+    (void)memset(logBuffers[0].data, 0xFF, sizeof(logBuffers[0].data));
+    logBuffers[0].length = 0u;
+    logBuffers[0].count = 0u;
+    logReady = true;
+
+    logMode = TELEMETRY_MODE_LP_ACTIVE;
+    logModeStart = TelemetryLog_GetTime();
+
+    record.time = logModeStart;
+    record.kind = TELEMETRY_REC_BOOT;
+    record.from = TELEMETRY_MODE_LP_ACTIVE;
+    record.to = TELEMETRY_MODE_LP_ACTIVE;
+    record.residency = 0u;
+    TelemetryLog_Append(&record);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_SetMode
+****************************************************************************//**
+*
+* Records a transition to mode, together with the time spent in the previous
+* mode. Only touches RAM.
+*
+*******************************************************************************/
+void TelemetryLog_SetMode(TelemetryMode mode)
+{
+    TelemetryRecord record;
+    uint64_t now;
+
+    if ((!logReady) || (mode == logMode))
+    {
+        return;
+    }
+
+    now = TelemetryLog_GetTime();
+
+    record.time = now;
+    record.kind = TELEMETRY_REC_TRANSITION;
+    record.from = (uint8_t)logMode;
+    record.to = (uint8_t)mode;
+    record.residency = ((now - logModeStart) > TELEMETRY_LOG_MAX_OFFSET) ?
+                       TELEMETRY_LOG_MAX_OFFSET : (uint32_t)(now - logModeStart);
+    TelemetryLog_Append(&record);
+
+    logMode = mode;
+    logModeStart = now;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_Process
+****************************************************************************//**
+*
+* Moves the log forward by at most one flash operation. Call from the main
+* loop. Nothing is written in System ULP mode or while the QSPI memory is
+* busy; the function never waits for the flash.
+*
+*******************************************************************************/
+void TelemetryLog_Process(void)
+{
+    TelemetryLogBuffer *buf;
+
+    if (!logReady)
+    {
+        return;
+    }
+
+    /* Do not keep a partially filled page in RAM for too long */
+    buf = TelemetryLog_FillBuffer();
+    if ((NULL != buf) && (0u != buf->count) &&
+        ((TelemetryLog_GetTime() - buf->baseTime) >= TELEMETRY_LOG_FLUSH_TICKS))
+    {
+        TelemetryLog_Seal();
+    }
+
+    if (Cy_SysPm_IsSystemUlp() || SmifMem_IsBusy())
+    {
+        return;
+    }
+
+    /* Complete the last operation */
+    if (logProgramming)
+    {
+        logProgramming = false;
+        logFullCount--;
+        logProgIdx = (logProgIdx + 1u) % TELEMETRY_LOG_BUFFERS;
+        logPage++;
+        TelemetryLog_HoldClock();
+    }
+
+    if (TELEMETRY_LOG_NO_SECTOR != logErasingSector)
+    {
+        if (logErasingSector == logSector)
+        {
+            logSectorErased = true;
+        }
+        else
+        {
+            logReadySector = logErasingSector;
+        }
+        logErasingSector = TELEMETRY_LOG_NO_SECTOR;
+    }
+
+    /* Move to the next sector of the ring */
+    if (TELEMETRY_PAGES_PER_SECTOR == logPage)
+    {
+        logSector = TelemetryLog_NextSector(logSector);
+        logPage = 0u;
+        logSectorErased = (logReadySector == logSector);
+        logReadySector = TELEMETRY_LOG_NO_SECTOR;
+    }
+
+    if (!logSectorErased)
+    {
+        TelemetryLog_StartErase(logSector);
+    }
+    else if (0u != logFullCount)
+    {
+        /* A failed page is retried, so pages are always written in order */
+        TelemetryLog_HoldFlash(true);
+        if (CY_SMIF_SUCCESS == SmifMem_ProgramPage(TelemetryLog_PageOffset(logSector, logPage),
+                                                   logBuffers[logProgIdx].data))
+        {
+            logProgramming = true;
+        }
+    }
+    else if ((TELEMETRY_LOG_NO_SECTOR == logReadySector) &&
+             ((logPage + TELEMETRY_LOG_ERASE_AHEAD) >= TELEMETRY_PAGES_PER_SECTOR))
+    {
+        /* Prepare the next sector once the current one is nearly full */
+        TelemetryLog_StartErase(TelemetryLog_NextSector(logSector));
+    }
+    else
+    {
+        /* Nothing to do */
+    }
+
+    TelemetryLog_HoldFlash(logProgramming || (TELEMETRY_LOG_NO_SECTOR != logErasingSector));
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_SetStackHighWater
+****************************************************************************//**
+*
+* Records the stack high-water mark of a core, in bytes, if it is higher than
+* the last one recorded. Only touches RAM.
+*
+*******************************************************************************/
+void TelemetryLog_SetStackHighWater(TelemetryCore core, uint32_t highWater)
+{
+    TelemetryRecord record;
+
+    if ((!logReady) || (highWater <= logStackHighWater[core]))
+    {
+        return;
+    }
+
+    record.time = TelemetryLog_GetTime();
+    record.kind = TELEMETRY_REC_STACK;
+    record.from = (uint8_t)core;
+    record.to = 0u;
+    record.residency = highWater;
+    TelemetryLog_Append(&record);
+
+    logStackHighWater[core] = highWater;
+}
+
+/*******************************************************************************
+* Function Name: TelemetryLog_GetDropCount
+****************************************************************************//**
+*
+* Returns the number of records lost because all RAM buffers were full.
+*
+*******************************************************************************/
+uint32_t TelemetryLog_GetDropCount(void)
+{
+    return logDropped;
+}
+
+/* [] END OF FILE */
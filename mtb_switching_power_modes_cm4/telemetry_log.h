@@ -0,0 +1,82 @@
+/***************************************************************************//**
+* \file telemetry_log.h
+* \version 1.0
+*
+* \brief
+* Persistent, append-only log of power mode transitions and residency on the
+* external QSPI memory. The stack high-water marks of both cores are logged
+* with them, each time one grows.
+*
+* Records are buffered in RAM, packed with telemetry_codec.c, and written a
+* full page at a time from the main loop, only in System LP mode. Recording a
+* record never touches the flash, so it is safe to call right after a
+* wake-up. Sectors are used round-robin; the next sector is erased in the
+* background once the current one is nearly full, not as soon as the current
+* one is entered or after each reset. An erase takes up to 2.6 s, during
+* which System Deep Sleep and System ULP are refused, so it only runs when
+* the log needs the sector.
+*
+* While pages wait to be written, the log holds a PM QoS minimum clock of
+* TELEMETRY_LOG_MIN_CLOCK_MHZ (see pm_qos.h): a wake-up from Deep Sleep then
+* waits for the FLL, so the pages are programmed with CLK_HF2 at full speed
+* rather than from the IMO. System ULP, at 50 MHz, still meets it.
+* After a reset the write position is recovered from the page headers, see
+* telemetry_format.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(TELEMETRY_LOG_H)
+#define TELEMETRY_LOG_H
+
+#include "cy_pdl.h"
+#include "time_base.h"
+#include "telemetry_format.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Number of RAM page buffers */
+#define TELEMETRY_LOG_BUFFERS       2u
+
+/* Page format written: TELEMETRY_PAGE_FORMAT_PACKED or TELEMETRY_PAGE_FORMAT_RAW.
+ * Both formats are always readable. */
+#if !defined(TELEMETRY_LOG_FORMAT)
+#define TELEMETRY_LOG_FORMAT        TELEMETRY_PAGE_FORMAT_PACKED
+#endif
+
+/* The next sector is erased once the current one has this many free pages
+ * left, so that the log does not stop at the sector boundary */
+#define TELEMETRY_LOG_ERASE_AHEAD   4u
+
+/* PM QoS minimum CLK_HF0 frequency while pages wait to be written */
+#define TELEMETRY_LOG_MIN_CLOCK_MHZ 50u
+
+/* A partially filled page is written once its first record is this old */
+#define TELEMETRY_LOG_FLUSH_TICKS   TIME_BASE_MS_TO_TICKS(300000u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool TelemetryLog_Init(void);
+void TelemetryLog_SetMode(TelemetryMode mode);
+void TelemetryLog_Process(void);
+void TelemetryLog_SetStackHighWater(TelemetryCore core, uint32_t highWater);
+uint32_t TelemetryLog_GetDropCount(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TELEMETRY_LOG_H */
+
+/* [] END OF FILE */
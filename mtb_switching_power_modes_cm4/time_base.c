@@ -0,0 +1,181 @@
+/***************************************************************************//**
+* \file time_base.c
+* \version 1.0
+*
+* \brief
+* Free-running time base in clk_lf ticks. See time_base.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "app_sections.h"
+#include "time_base.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Time to wait for the MCWDT to synchronize with clk_lf (in microseconds) */
+#define TIME_BASE_SYNC_US           93u
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint64_t timeBaseTicks = 0u;         /* Time base ticks at the last sample */
+static uint32_t timeBaseLastLow = 0u;       /* Counter at the last sample */
+static uint32_t timeBaseClockHz = TIME_BASE_ILO_HZ;
+static uint32_t timeBaseRemainder = 0u;     /* Scaled counts not yet a tick */
+
+
+/*******************************************************************************
+* Function Name: TimeBase_Sample
+****************************************************************************//**
+*
+* Adds the counts since the last sample, converted at the current clk_lf
+* rate, to the time base. Call in a critical section.
+*
+*******************************************************************************/
+static uint64_t TimeBase_Sample(void)
+{
+    uint32_t low = Cy_MCWDT_GetCount(TIME_BASE_MCWDT_HW, TIME_BASE_MCWDT_COUNTER);
+    uint32_t counts = low - timeBaseLastLow;    /* Modulo 2^32, across a wrap */
+    uint64_t scaled;
+
+    timeBaseLastLow = low;
+
+    if (TIME_BASE_TICKS_PER_SEC == timeBaseClockHz)
+    {
+        timeBaseTicks += counts;
+    }
+    else
+    {
+        scaled = ((uint64_t)counts * TIME_BASE_TICKS_PER_SEC) + timeBaseRemainder;
+        timeBaseTicks += scaled / timeBaseClockHz;
+        timeBaseRemainder = (uint32_t)(scaled % timeBaseClockHz);
+    }
+
+    return timeBaseTicks;
+}
+
+
+/*******************************************************************************
+* Function Name: TimeBase_Init
+****************************************************************************//**
+*
+* Configures and starts counter 2 of the MCWDT and enables its interrupt on
+* the CM4. The time base starts at 0, at the rate of the current clk_lf
+* source.
+*
+*******************************************************************************/
+APP_COLD void TimeBase_Init(void)
+{
+    const cy_stc_mcwdt_config_t mcwdtConfig =
+    {
+        .c0Match        = 0u,
+        .c1Match        = 0u,
+        .c0Mode         = CY_MCWDT_MODE_NONE,
+        .c1Mode         = CY_MCWDT_MODE_NONE,
+        .c2ToggleBit    = TIME_BASE_TOGGLE_BIT,
+        .c2Mode         = CY_MCWDT_MODE_INT,
+        .c0ClearOnMatch = false,
+        .c1ClearOnMatch = false,
+        .c0c1Cascade    = false,
+        .c1c2Cascade    = false
+    };
+
+    const cy_stc_sysint_t mcwdtIsr =
+    {
+        .intrSrc      = TIME_BASE_IRQ,
+        .intrPriority = TIME_BASE_INTR_PRIORITY,
+    };
+
+    (void)Cy_MCWDT_Init(TIME_BASE_MCWDT_HW, &mcwdtConfig);
+    Cy_MCWDT_SetInterruptMask(TIME_BASE_MCWDT_HW, TIME_BASE_MCWDT_MASK);
+
+    (void)Cy_SysInt_Init(&mcwdtIsr, TimeBase_InterruptHandler);
+    NVIC_EnableIRQ(mcwdtIsr.intrSrc);
+
+    Cy_MCWDT_Enable(TIME_BASE_MCWDT_HW, TIME_BASE_MCWDT_MASK, TIME_BASE_SYNC_US);
+
+    timeBaseClockHz = (CY_SYSCLK_CLKLF_IN_WCO == Cy_SysClk_ClkLfGetSource()) ?
+                      TIME_BASE_WCO_HZ : TIME_BASE_ILO_HZ;
+    timeBaseLastLow = Cy_MCWDT_GetCount(TIME_BASE_MCWDT_HW, TIME_BASE_MCWDT_COUNTER);
+}
+
+/*******************************************************************************
+* Function Name: TimeBase_GetTicks
+****************************************************************************//**
+*
+* Returns the number of time base ticks since TimeBase_Init() was called.
+*
+*******************************************************************************/
+uint64_t TimeBase_GetTicks(void)
+{
+    uint32_t interruptState;
+    uint64_t ticks;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    ticks = TimeBase_Sample();
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    return ticks;
+}
+
+/*******************************************************************************
+* Function Name: TimeBase_SetClockHz
+****************************************************************************//**
+*
+* Sets the rate of clk_lf, TIME_BASE_ILO_HZ or TIME_BASE_WCO_HZ. Call right
+* after changing its source: the counts until then are converted at the
+* previous rate.
+*
+*******************************************************************************/
+void TimeBase_SetClockHz(uint32_t clockHz)
+{
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+
+    (void)TimeBase_Sample();
+    timeBaseClockHz = clockHz;
+    timeBaseRemainder = 0u;
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: TimeBase_GetClockHz
+****************************************************************************//**
+*
+* Returns the rate of clk_lf that the counts are converted at.
+*
+*******************************************************************************/
+uint32_t TimeBase_GetClockHz(void)
+{
+    return timeBaseClockHz;
+}
+
+/*******************************************************************************
+* Function Name: TimeBase_InterruptHandler
+****************************************************************************//**
+*
+* MCWDT counter 2 toggle handler. Samples the counter so that no wrap is
+* missed. Also clears the interrupts of the other counters of the block, which
+* are only used as wake-up sources.
+*
+*******************************************************************************/
+void TimeBase_InterruptHandler(void)
+{
+    Cy_MCWDT_ClearInterrupt(TIME_BASE_MCWDT_HW, Cy_MCWDT_GetInterruptStatusMasked(TIME_BASE_MCWDT_HW));
+
+    (void)TimeBase_GetTicks();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,76 @@
+/***************************************************************************//**
+* \file time_base.h
+* \version 1.0
+*
+* \brief
+* Free-running time base in ticks of 1/32768 s that keeps counting in System
+* Deep Sleep.
+*
+* Counter 2 of MCWDT1 (32 bits) counts clk_lf and is extended to 64 bits in
+* software. The counter interrupt fires on each toggle of bit
+* TIME_BASE_TOGGLE_BIT, which guarantees the counter is sampled at least
+* twice per wrap even if nothing else reads the time base.
+*
+* clk_lf starts on the ILO (32000 Hz) and moves to the WCO (32768 Hz), see
+* lf_clock.h. The counter is converted to time base ticks at the rate of the
+* current source, so durations keep their unit across the switch. On the ILO
+* they are still only as accurate as the ILO itself.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(TIME_BASE_H)
+#define TIME_BASE_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define TIME_BASE_MCWDT_HW          MCWDT_STRUCT1
+#define TIME_BASE_MCWDT_COUNTER     CY_MCWDT_COUNTER2
+#define TIME_BASE_MCWDT_MASK        CY_MCWDT_CTR2
+#define TIME_BASE_IRQ               srss_interrupt_mcwdt_1_IRQn
+#define TIME_BASE_INTR_PRIORITY     7u
+
+/* Counter bit that raises the interrupt (~18 hours between interrupts) */
+#define TIME_BASE_TOGGLE_BIT        30u
+
+/* Tick rate of the time base */
+#define TIME_BASE_TICKS_PER_SEC     32768u
+
+/* Nominal clk_lf rates of the ILO and WCO */
+#define TIME_BASE_ILO_HZ            32000u
+#define TIME_BASE_WCO_HZ            32768u
+
+/* Converts milliseconds to ticks */
+#define TIME_BASE_MS_TO_TICKS(ms)   (((uint64_t)(ms) * TIME_BASE_TICKS_PER_SEC) / 1000u)
+
+/* Converts ticks to microseconds */
+#define TIME_BASE_TICKS_TO_US(t)    ((uint32_t)(((uint64_t)(t) * 1000000u) / TIME_BASE_TICKS_PER_SEC))
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void TimeBase_Init(void);
+uint64_t TimeBase_GetTicks(void);
+void TimeBase_SetClockHz(uint32_t clockHz);
+uint32_t TimeBase_GetClockHz(void);
+void TimeBase_InterruptHandler(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TIME_BASE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+################################################################################
+# \file gen_hw_descriptors.py
+# \version 1.0
+#
+# \brief
+# Generates hw_descriptors.hpp, the compile-time pin and TCPWM counter
+# descriptors of mtb_switching_power_modes_cm4 (see hw_regs.hpp), from the
+# cycfg_pins.h and cycfg_peripherals.h files of the Device Configurator.
+#
+# Usage: gen_hw_descriptors.py <GeneratedSource directory> <output file>
+#
+# Run it again after changing the design. The descriptors take the port, pin
+# and counter numbers from the configurator macros, so only renamed, added
+# or removed pins and counters, or a counter moved to another TCPWM block,
+# need a new header.
+#
+################################################################################
+# \copyright
+# Copyright 2018-2019 Cypress Semiconductor Corporation
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+import os
+import re
+import sys
+
+DEFINE = re.compile(r'^\s*#define\s+(\w+)\s+(.+?)\s*$')
+TCPWM_BLOCK = re.compile(r'^TCPWM\d+$')
+
+HEADER = '''/***************************************************************************//**
+* \\file hw_descriptors.hpp
+* \\version 1.0
+*
+* \\brief
+* Descriptors of the configured pins and TCPWM counters (see hw_regs.hpp).
+*
+* Generated by tools/hwdesc/gen_hw_descriptors.py from cycfg_pins.h and
+* cycfg_peripherals.h. Do not edit.
+*
+********************************************************************************
+* \\copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(HW_DESCRIPTORS_HPP)
+#define HW_DESCRIPTORS_HPP
+
+#include "cycfg_pins.h"
+#include "cycfg_peripherals.h"
+#include "hw_regs.hpp"
+
+namespace hw
+{
+'''
+
+FOOTER = '''
+} /* namespace hw */
+
+#endif /* HW_DESCRIPTORS_HPP */
+
+/* [] END OF FILE */
+'''
+
+
+def read_defines(path):
+    """Returns the macros of a header as an ordered name -> value dict."""
+    defines = {}
+    with open(path) as header:
+        for line in header:
+            match = DEFINE.match(line)
+            if match:
+                defines[match.group(1)] = match.group(2)
+    return defines
+
+
+def type_name(prefix):
+    """KIT_LED1_PWM -> KitLed1Pwm, ioss_0_port_6_pin_0 -> Ioss0Port6Pin0."""
+    return ''.join(word[:1].upper() + word[1:].lower()
+                   for word in prefix.split('_') if word)
+
+
+def pins(defines):
+    """Pins that have both a port number and a pin number."""
+    for name in defines:
+        if name.endswith('_PORT_NUM'):
+            prefix = name[:-len('_PORT_NUM')]
+            if prefix + '_NUM' in defines:
+                yield prefix
+
+
+def counters(defines):
+    """Peripherals that are a counter of a TCPWM block."""
+    for name, value in defines.items():
+        if name.endswith('_HW') and TCPWM_BLOCK.match(value):
+            prefix = name[:-len('_HW')]
+            if prefix + '_NUM' in defines:
+                yield prefix, value
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.exit('usage: %s <GeneratedSource directory> <output file>' % argv[0])
+
+    pin_defines = read_defines(os.path.join(argv[1], 'cycfg_pins.h'))
+    peripheral_defines = read_defines(os.path.join(argv[1], 'cycfg_peripherals.h'))
+
+    lines = [HEADER, '/* Pins (cycfg_pins.h) */']
+    for prefix in pins(pin_defines):
+        lines.append('using %s = Pin<%s_PORT_NUM, %s_NUM>;'
+                     % (type_name(prefix), prefix, prefix))
+
+    lines.append('')
+    lines.append('/* TCPWM counters (cycfg_peripherals.h) */')
+    for prefix, block in counters(peripheral_defines):
+        lines.append('using %s = TcpwmCounter<%s_BASE, %s_NUM>;'
+                     % (type_name(prefix), block, prefix))
+
+    with open(argv[2], 'w') as output:
+        output.write('\n'.join(lines) + '\n' + FOOTER)
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -0,0 +1,657 @@
+/***************************************************************************//**
+* \file teldump.c
+* \version 1.0
+*
+* \brief
+* Decoder and indexer for raw dumps of the QSPI memory (base 0x18000000) or of
+* the telemetry log region alone.
+*
+* The dump is memory-mapped. At load time the log is indexed per sector: the
+* sequence number and base time of its first page, its used pages, and the
+* modes of the transitions it holds. The sectors are ordered by sequence
+* number, with wrap-around. A binary search over the sector base times, then
+* over the page base times of one sector, finds where a time range starts,
+* and a listing for one mode skips the sectors without it. Times are log
+* times in seconds.
+*
+* Usage:
+*   teldump [-o offset] dump info
+*   teldump [-o offset] dump list [t1 [t2]] [mode]
+*   teldump [-o offset] dump residency [t1 [t2]]
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "telemetry_format.h"
+#include "telemetry_codec.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define DUMP_TICKS_PER_SEC      32768.0
+#define DUMP_TIME_MAX           UINT64_MAX
+#define DUMP_NO_MODE            0xFFu
+#define DUMP_MODE_BIT(mode)     ((uint8_t)(1u << (mode)))
+
+typedef struct
+{
+    uint32_t sector;        /* Sector index in the region */
+    uint32_t firstSeq;      /* Sequence number of its first page */
+    uint32_t usedPages;     /* Pages programmed since the last erase */
+    uint64_t baseTime;      /* Base time of its first page */
+    uint8_t  modes;         /* DUMP_MODE_BIT() of the modes entered or left */
+} DumpSector;
+
+typedef struct
+{
+    const uint8_t *region;
+    DumpSector sectors[TELEMETRY_LOG_SECTORS];
+    uint32_t sectorCount;   /* Sectors holding log data, oldest first */
+    uint32_t pageCount;     /* Pages in those sectors, in log order */
+} DumpLog;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char *const dumpModeNames[TELEMETRY_MODE_COUNT] =
+{
+    "lp-active", "ulp-active", "lp-sleep", "ulp-sleep", "deep-sleep"
+};
+
+
+/*******************************************************************************
+* Function Name: Dump_Page
+****************************************************************************//**
+*
+* Returns a page in log order: index counts across the ordered sectors.
+*
+*******************************************************************************/
+static const uint8_t *Dump_Page(const DumpLog *log, uint32_t index)
+{
+    const DumpSector *sector = &log->sectors[index / TELEMETRY_PAGES_PER_SECTOR];
+
+    return log->region + ((size_t)sector->sector * TELEMETRY_SECTOR_SIZE) +
+           ((size_t)(index % TELEMETRY_PAGES_PER_SECTOR) * TELEMETRY_PAGE_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: Dump_IsUsed
+****************************************************************************//**
+*
+* Returns true if index is a page of the log that was programmed.
+*
+*******************************************************************************/
+static int Dump_IsUsed(const DumpLog *log, uint32_t index)
+{
+    return (index % TELEMETRY_PAGES_PER_SECTOR) <
+           log->sectors[index / TELEMETRY_PAGES_PER_SECTOR].usedPages;
+}
+
+/*******************************************************************************
+* Function Name: Dump_CompareSectors
+****************************************************************************//**
+*
+* qsort() comparison: orders sectors by their first sequence number. The
+* sequence number wraps, so they are compared by their signed difference: the
+* sectors of the ring span far less than half of the sequence space.
+*
+*******************************************************************************/
+static int Dump_CompareSectors(const void *a, const void *b)
+{
+    int32_t diff = (int32_t)(((const DumpSector *)a)->firstSeq - ((const DumpSector *)b)->firstSeq);
+
+    return (diff > 0) - (diff < 0);
+}
+
+/*******************************************************************************
+* Function Name: Dump_IndexModes
+****************************************************************************//**
+*
+* Returns the DUMP_MODE_BIT() mask of the modes entered or left in the used
+* pages of a sector. Torn pages are skipped.
+*
+*******************************************************************************/
+static uint8_t Dump_IndexModes(const uint8_t *base, uint32_t usedPages)
+{
+    TelemetryPageHeader header;
+    TelemetryPageReader reader;
+    TelemetryRecord record;
+    const uint8_t *page;
+    uint32_t i;
+    uint8_t modes = 0u;
+
+    for (i = 0u; i < usedPages; i++)
+    {
+        page = base + ((size_t)i * TELEMETRY_PAGE_SIZE);
+        if (!TelemetryFormat_ReadHeader(page, &header))
+        {
+            continue;
+        }
+
+        TelemetryCodec_OpenPage(&reader, page, &header);
+        while (TelemetryCodec_NextRecord(&reader, &record))
+        {
+            if ((TELEMETRY_REC_TRANSITION == record.kind) &&
+                (record.from < TELEMETRY_MODE_COUNT) && (record.to < TELEMETRY_MODE_COUNT))
+            {
+                modes |= DUMP_MODE_BIT(record.from) | DUMP_MODE_BIT(record.to);
+            }
+        }
+    }
+
+    return modes;
+}
+
+/*******************************************************************************
+* Function Name: Dump_Open
+****************************************************************************//**
+*
+* Builds the sector index and rebuilds the page order of the log from it.
+* Sectors are all laid out as full in the logical page index; unused pages
+* are skipped by the readers.
+*
+*******************************************************************************/
+static void Dump_Open(DumpLog *log, const uint8_t *region)
+{
+    TelemetryPageHeader header;
+    const uint8_t *base;
+    uint32_t sector;
+    uint32_t low;
+    uint32_t high;
+    uint32_t mid;
+
+    log->region = region;
+    log->sectorCount = 0u;
+
+    for (sector = 0u; sector < TELEMETRY_LOG_SECTORS; sector++)
+    {
+        base = region + ((size_t)sector * TELEMETRY_SECTOR_SIZE);
+        if (!TelemetryFormat_ReadHeader(base, &header))
+        {
+            continue;
+        }
+
+        /* Pages are programmed in order: find the first erased one */
+        low = 1u;
+        high = TELEMETRY_PAGES_PER_SECTOR;
+        while (low < high)
+        {
+            mid = low + ((high - low) / 2u);
+            if (TelemetryFormat_IsErased(base + ((size_t)mid * TELEMETRY_PAGE_SIZE)))
+            {
+                high = mid;
+            }
+            else
+            {
+                low = mid + 1u;
+            }
+        }
+
+        log->sectors[log->sectorCount].sector = sector;
+        log->sectors[log->sectorCount].firstSeq = header.seq;
+        log->sectors[log->sectorCount].usedPages = low;
+        log->sectors[log->sectorCount].baseTime = header.baseTime;
+        log->sectors[log->sectorCount].modes = Dump_IndexModes(base, low);
+        log->sectorCount++;
+    }
+
+    qsort(log->sectors, log->sectorCount, sizeof(log->sectors[0]), Dump_CompareSectors);
+    log->pageCount = log->sectorCount * TELEMETRY_PAGES_PER_SECTOR;
+}
+
+/*******************************************************************************
+* Function Name: Dump_PageTime
+****************************************************************************//**
+*
+* Returns the base time of the last valid page at or before index, or 0 if
+* there is none. Non-decreasing in index, so it can be binary-searched.
+*
+*******************************************************************************/
+static uint64_t Dump_PageTime(const DumpLog *log, uint32_t index)
+{
+    TelemetryPageHeader header;
+
+    for (;;)
+    {
+        if (Dump_IsUsed(log, index) && TelemetryFormat_ReadHeader(Dump_Page(log, index), &header))
+        {
+            return header.baseTime;
+        }
+        if (0u == index)
+        {
+            return 0u;
+        }
+        index--;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Dump_FindPage
+****************************************************************************//**
+*
+* Returns the last page whose base time is before time, so the first record
+* at or after time is in that page or a later one. Only the pages of one
+* sector are read.
+*
+*******************************************************************************/
+static uint32_t Dump_FindPage(const DumpLog *log, uint64_t time)
+{
+    uint32_t low = 0u;
+    uint32_t high = log->sectorCount;
+    uint32_t mid;
+
+    /* First sector with a base time at or after time, from the index */
+    while (low < high)
+    {
+        mid = low + ((high - low) / 2u);
+        if (log->sectors[mid].baseTime >= time)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1u;
+        }
+    }
+
+    if (0u == low)
+    {
+        return 0u;
+    }
+
+    /* The page is in the sector before it, or is its first page */
+    low = (low - 1u) * TELEMETRY_PAGES_PER_SECTOR;
+    high = ((low + TELEMETRY_PAGES_PER_SECTOR) < log->pageCount) ?
+           (low + TELEMETRY_PAGES_PER_SECTOR) : log->pageCount;
+
+    /* First page with a base time at or after time */
+    while (low < high)
+    {
+        mid = low + ((high - low) / 2u);
+        if (Dump_PageTime(log, mid) >= time)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1u;
+        }
+    }
+
+    return (low > 0u) ? (low - 1u) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: Dump_ToTicks
+****************************************************************************//**
+*
+* Converts a time in seconds to clk_lf ticks.
+*
+*******************************************************************************/
+static uint64_t Dump_ToTicks(const char *text)
+{
+    return (uint64_t)(strtod(text, NULL) * DUMP_TICKS_PER_SEC);
+}
+
+/*******************************************************************************
+* Function Name: Dump_ToSeconds
+****************************************************************************//**
+*
+* Converts clk_lf ticks to seconds.
+*
+*******************************************************************************/
+static double Dump_ToSeconds(uint64_t ticks)
+{
+    return (double)ticks / DUMP_TICKS_PER_SEC;
+}
+
+/*******************************************************************************
+* Function Name: Dump_ParseMode
+****************************************************************************//**
+*
+* Returns the mode with the given name, or DUMP_NO_MODE.
+*
+*******************************************************************************/
+static uint8_t Dump_ParseMode(const char *name)
+{
+    uint8_t mode;
+
+    for (mode = 0u; mode < TELEMETRY_MODE_COUNT; mode++)
+    {
+        if (0 == strcmp(name, dumpModeNames[mode]))
+        {
+            return mode;
+        }
+    }
+
+    return DUMP_NO_MODE;
+}
+
+/*******************************************************************************
+* Function Name: Dump_ModeName
+****************************************************************************//**
+*
+* Returns the name of a mode.
+*
+*******************************************************************************/
+static const char *Dump_ModeName(uint8_t mode)
+{
+    return (mode < TELEMETRY_MODE_COUNT) ? dumpModeNames[mode] : "?";
+}
+
+/*******************************************************************************
+* Function Name: Dump_Info
+****************************************************************************//**
+*
+* Prints the layout of the log. Touches only the sector headers and the first
+* and last pages.
+*
+*******************************************************************************/
+static void Dump_Info(const DumpLog *log)
+{
+    const DumpSector *last;
+    uint32_t i;
+
+    printf("sectors in use   : %u of %u\n", log->sectorCount, TELEMETRY_LOG_SECTORS);
+    for (i = 0u; i < log->sectorCount; i++)
+    {
+        printf("  sector %2u      : seq %u, %u pages, from %.3f s\n",
+               log->sectors[i].sector, log->sectors[i].firstSeq, log->sectors[i].usedPages,
+               Dump_ToSeconds(log->sectors[i].baseTime));
+    }
+
+    if (0u != log->sectorCount)
+    {
+        last = &log->sectors[log->sectorCount - 1u];
+        printf("time range       : %.3f s .. %.3f s (page base times)\n",
+               Dump_ToSeconds(log->sectors[0].baseTime),
+               Dump_ToSeconds(Dump_PageTime(log, ((log->sectorCount - 1u) * TELEMETRY_PAGES_PER_SECTOR) +
+                                                 last->usedPages - 1u)));
+    }
+}
+
+/*******************************************************************************
+* Function Name: Dump_Scan
+****************************************************************************//**
+*
+* Calls visit for every record from the first record at or after t1 up to and
+* including the first record at or after t2 (the one that closes the interval
+* containing t2). Torn pages are skipped. Unless mode is DUMP_NO_MODE, the
+* sectors without a transition in or out of mode are skipped too, and the
+* scan ends at the first sector that starts after t2.
+*
+*******************************************************************************/
+static void Dump_Scan(const DumpLog *log, uint64_t t1, uint64_t t2, uint8_t mode,
+                      void (*visit)(const TelemetryRecord *record, void *arg), void *arg)
+{
+    TelemetryPageHeader header;
+    TelemetryPageReader reader;
+    TelemetryRecord record;
+    const DumpSector *sector;
+    uint32_t index;
+
+    for (index = Dump_FindPage(log, t1); index < log->pageCount; index++)
+    {
+        sector = &log->sectors[index / TELEMETRY_PAGES_PER_SECTOR];
+        if ((DUMP_NO_MODE != mode) && (0u == (sector->modes & DUMP_MODE_BIT(mode))))
+        {
+            if (sector->baseTime > t2)
+            {
+                return;
+            }
+
+            /* Last page of the sector, the loop moves to the next one */
+            index = (((index / TELEMETRY_PAGES_PER_SECTOR) + 1u) * TELEMETRY_PAGES_PER_SECTOR) - 1u;
+            continue;
+        }
+
+        if (!Dump_IsUsed(log, index) || !TelemetryFormat_ReadHeader(Dump_Page(log, index), &header))
+        {
+            continue;
+        }
+
+        TelemetryCodec_OpenPage(&reader, Dump_Page(log, index), &header);
+        while (TelemetryCodec_NextRecord(&reader, &record))
+        {
+            if (record.time < t1)
+            {
+                continue;
+            }
+
+            visit(&record, arg);
+
+            if (record.time >= t2)
+            {
+                return;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Record listing
+*******************************************************************************/
+typedef struct
+{
+    uint64_t t2;
+    uint8_t  mode;                          /* DUMP_NO_MODE lists all modes */
+} DumpFilter;
+
+/*******************************************************************************
+* Function Name: Dump_PrintRecord
+****************************************************************************//**
+*
+* Dump_Scan() visitor of the list command.
+*
+*******************************************************************************/
+static void Dump_PrintRecord(const TelemetryRecord *record, void *arg)
+{
+    const DumpFilter *filter = (const DumpFilter *)arg;
+
+    if ((record->time > filter->t2) ||
+        ((DUMP_NO_MODE != filter->mode) &&
+         ((TELEMETRY_REC_STACK == record->kind) || ((record->from != filter->mode) && (record->to != filter->mode)))))
+    {
+        return;
+    }
+
+    if (TELEMETRY_REC_BOOT == record->kind)
+    {
+        printf("%14.3f  boot\n", Dump_ToSeconds(record->time));
+    }
+    else if (TELEMETRY_REC_STACK == record->kind)
+    {
+        printf("%14.3f  stack %-4s %u bytes\n", Dump_ToSeconds(record->time),
+               (TELEMETRY_CORE_CM0P == record->from) ? "cm0p" : "cm4", (unsigned int)record->residency);
+    }
+    else
+    {
+        printf("%14.3f  %-10s -> %-10s  (%.3f s)\n", Dump_ToSeconds(record->time),
+               Dump_ModeName(record->from), Dump_ModeName(record->to), Dump_ToSeconds(record->residency));
+    }
+}
+
+/*******************************************************************************
+* Residency accumulation
+*******************************************************************************/
+typedef struct
+{
+    uint64_t t1;
+    uint64_t t2;
+    uint64_t first;                         /* Covered range */
+    uint64_t last;
+    uint64_t ticks[TELEMETRY_MODE_COUNT];
+} DumpResidency;
+
+/*******************************************************************************
+* Function Name: Dump_AddResidency
+****************************************************************************//**
+*
+* Dump_Scan() visitor of the residency command. A transition record at time t
+* with residency r means [t - r, t] was spent in the mode left; only the part
+* inside [t1, t2] is counted.
+*
+*******************************************************************************/
+static void Dump_AddResidency(const TelemetryRecord *record, void *arg)
+{
+    DumpResidency *res = (DumpResidency *)arg;
+    uint64_t start;
+    uint64_t end;
+
+    if ((TELEMETRY_REC_TRANSITION != record->kind) || (record->from >= TELEMETRY_MODE_COUNT))
+    {
+        return;
+    }
+
+    start = (record->time > record->residency) ? (record->time - record->residency) : 0u;
+    end = record->time;
+    start = (start < res->t1) ? res->t1 : start;
+    end = (end > res->t2) ? res->t2 : end;
+
+    if (end > start)
+    {
+        res->ticks[record->from] += end - start;
+        res->first = (start < res->first) ? start : res->first;
+        res->last = (end > res->last) ? end : res->last;
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+****************************************************************************//**
+*
+* Maps the dump and runs a command.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    DumpLog log;
+    DumpFilter filter;
+    DumpResidency res;
+    struct stat st;
+    const uint8_t *image;
+    size_t offset = 0u;
+    int offsetSet = 0;
+    int argi = 1;
+    int times = 0;
+    int fd;
+    uint8_t mode = DUMP_NO_MODE;
+    uint64_t t1 = 0u;
+    uint64_t t2 = DUMP_TIME_MAX;
+    uint64_t total;
+    const char *command;
+    uint32_t i;
+
+    if ((argc > 2) && (0 == strcmp(argv[1], "-o")))
+    {
+        offset = (size_t)strtoul(argv[2], NULL, 0);
+        offsetSet = 1;
+        argi = 3;
+    }
+
+    if ((argc - argi) < 2)
+    {
+        fprintf(stderr, "usage: %s [-o offset] dump info|list [t1 [t2]] [mode]|residency [t1 [t2]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    fd = open(argv[argi], O_RDONLY);
+    if ((fd < 0) || (0 != fstat(fd, &st)))
+    {
+        perror(argv[argi]);
+        return EXIT_FAILURE;
+    }
+
+    /* A full memory image holds the log at its usual place */
+    if (!offsetSet && ((size_t)st.st_size == TELEMETRY_FLASH_SIZE))
+    {
+        offset = TELEMETRY_LOG_OFFSET;
+    }
+    if (((size_t)st.st_size < offset) || (((size_t)st.st_size - offset) < TELEMETRY_LOG_SIZE))
+    {
+        fprintf(stderr, "%s: too small for the log region at offset 0x%zx\n", argv[argi], offset);
+        return EXIT_FAILURE;
+    }
+
+    image = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == image)
+    {
+        perror("mmap");
+        return EXIT_FAILURE;
+    }
+
+    Dump_Open(&log, image + offset);
+
+    command = argv[argi + 1];
+    for (argi += 2; argi < argc; argi++)
+    {
+        if (DUMP_NO_MODE != Dump_ParseMode(argv[argi]))
+        {
+            mode = Dump_ParseMode(argv[argi]);
+        }
+        else if (0 == times++)
+        {
+            t1 = Dump_ToTicks(argv[argi]);
+        }
+        else
+        {
+            t2 = Dump_ToTicks(argv[argi]);
+        }
+    }
+
+    if (0 == strcmp(command, "info"))
+    {
+        Dump_Info(&log);
+    }
+    else if (0 == strcmp(command, "list"))
+    {
+        filter.t2 = t2;
+        filter.mode = mode;
+        Dump_Scan(&log, t1, t2, mode, Dump_PrintRecord, &filter);
+    }
+    else if (0 == strcmp(command, "residency"))
+    {
+        memset(&res, 0, sizeof(res));
+        res.t1 = t1;
+        res.t2 = t2;
+        res.first = DUMP_TIME_MAX;
+        Dump_Scan(&log, t1, t2, DUMP_NO_MODE, Dump_AddResidency, &res);
+
+        total = (res.last > res.first) ? (res.last - res.first) : 0u;
+        printf("logged range     : %.3f s .. %.3f s\n",
+               (0u != total) ? Dump_ToSeconds(res.first) : 0.0, Dump_ToSeconds(res.last));
+        for (i = 0u; i < TELEMETRY_MODE_COUNT; i++)
+        {
+            printf("%-17s: %14.3f s  %6.2f %%\n", dumpModeNames[i], Dump_ToSeconds(res.ticks[i]),
+                   (0u != total) ? (100.0 * (double)res.ticks[i] / (double)total) : 0.0);
+        }
+    }
+    else
+    {
+        fprintf(stderr, "unknown command: %s\n", command);
+        return EXIT_FAILURE;
+    }
+
+    munmap((void *)image, (size_t)st.st_size);
+    close(fd);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
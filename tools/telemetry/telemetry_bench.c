@@ -0,0 +1,265 @@
+/***************************************************************************//**
+* \file telemetry_bench.c
+* \version 1.0
+*
+* \brief
+* Host benchmark of the telemetry codec. Encodes a synthetic stream of power
+* mode transitions into sealed pages, decodes and checks them, and reports
+* the throughput of both directions and the size against the raw format.
+*
+* Usage: telemetry_bench [records]
+*
+********************************************************************************
+* \copyright
+* Copyright 2017-2019, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "telemetry_format.h"
+#include "telemetry_codec.h"
+
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define BENCH_DEFAULT_RECORDS   4000000u
+#define BENCH_TICKS_PER_SEC     32768u
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t benchSeed = 0x12345678u;
+
+
+/*******************************************************************************
+* Function Name: Bench_Random
+****************************************************************************//**
+*
+* xorshift32 pseudo-random generator, so runs are repeatable.
+*
+*******************************************************************************/
+static uint32_t Bench_Random(void)
+{
+    benchSeed ^= benchSeed << 13u;
+    benchSeed ^= benchSeed >> 17u;
+    benchSeed ^= benchSeed << 5u;
+    return benchSeed;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Now
+****************************************************************************//**
+*
+* Returns a monotonic time in seconds.
+*
+*******************************************************************************/
+static double Bench_Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Generate
+****************************************************************************//**
+*
+* Fills records with a device that mostly alternates between LP Active and
+* Deep Sleep, with the occasional Sleep or ULP excursion, as the demo does.
+*
+*******************************************************************************/
+static void Bench_Generate(TelemetryRecord *records, size_t count)
+{
+    static const uint8_t excursions[] =
+    {
+        TELEMETRY_MODE_LP_SLEEP, TELEMETRY_MODE_ULP_ACTIVE, TELEMETRY_MODE_ULP_SLEEP
+    };
+    uint64_t time = 0u;
+    uint64_t modeStart = 0u;
+    uint8_t mode = TELEMETRY_MODE_LP_ACTIVE;
+    uint8_t next;
+    size_t i;
+
+    for (i = 0u; i < count; i++)
+    {
+        if (TELEMETRY_MODE_LP_ACTIVE != mode)
+        {
+            next = TELEMETRY_MODE_LP_ACTIVE;
+            time += (uint64_t)(Bench_Random() % (600u * BENCH_TICKS_PER_SEC));
+        }
+        else
+        {
+            next = ((Bench_Random() % 16u) == 0u) ? excursions[Bench_Random() % 3u] : TELEMETRY_MODE_DEEP_SLEEP;
+            time += (uint64_t)(Bench_Random() % (5u * BENCH_TICKS_PER_SEC));
+        }
+
+        records[i].time = time;
+        records[i].kind = TELEMETRY_REC_TRANSITION;
+        records[i].from = mode;
+        records[i].to = next;
+        records[i].residency = (uint32_t)(time - modeStart);
+
+        mode = next;
+        modeStart = time;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Encode
+****************************************************************************//**
+*
+* Encodes records into sealed packed pages. Returns the number of pages.
+*
+*******************************************************************************/
+static size_t Bench_Encode(const TelemetryRecord *records, size_t count, uint8_t *pages, size_t *payloadBytes)
+{
+    TelemetryCodecState codec;
+    TelemetryPageHeader header = { TELEMETRY_PAGE_MAGIC, 0u, 0u, 0u, TELEMETRY_PAGE_FORMAT_PACKED, 0u, 0u };
+    uint8_t *page = pages;
+    size_t n;
+    size_t i = 0u;
+
+    *payloadBytes = 0u;
+    while (i < count)
+    {
+        memset(page, 0xFF, TELEMETRY_PAGE_SIZE);
+        header.baseTime = records[i].time;
+        header.length = 0u;
+        header.count = 0u;
+        TelemetryCodec_Reset(&codec, header.baseTime);
+
+        while ((i < count) &&
+               (0u != (n = TelemetryCodec_Encode(&codec, &page[TELEMETRY_HEADER_SIZE], header.length,
+                                                 TELEMETRY_PAYLOAD_SIZE, &records[i]))))
+        {
+            header.length += (uint16_t)n;
+            header.count++;
+            i++;
+        }
+
+        TelemetryFormat_SealPage(page, &header);
+        *payloadBytes += header.length;
+        header.seq++;
+        page += TELEMETRY_PAGE_SIZE;
+    }
+
+    return header.seq;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Decode
+****************************************************************************//**
+*
+* Decodes and validates pages into records. Returns the number of records.
+*
+*******************************************************************************/
+static size_t Bench_Decode(const uint8_t *pages, size_t pageCount, TelemetryRecord *records)
+{
+    TelemetryPageHeader header;
+    TelemetryPageReader reader;
+    size_t count = 0u;
+    size_t p;
+
+    for (p = 0u; p < pageCount; p++)
+    {
+        if (TelemetryFormat_ReadHeader(&pages[p * TELEMETRY_PAGE_SIZE], &header))
+        {
+            TelemetryCodec_OpenPage(&reader, &pages[p * TELEMETRY_PAGE_SIZE], &header);
+            while (TelemetryCodec_NextRecord(&reader, &records[count]))
+            {
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: main
+****************************************************************************//**
+*
+* Runs the benchmark and prints the results.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    size_t count = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_RECORDS;
+    TelemetryRecord *records = malloc(count * sizeof(*records));
+    TelemetryRecord *decoded = malloc(count * sizeof(*decoded));
+    /* Every page holds at least two records */
+    uint8_t *pages = malloc(((count / 2u) + 1u) * TELEMETRY_PAGE_SIZE);
+    size_t pageCount;
+    size_t payloadBytes;
+    size_t rawPages;
+    size_t decodedCount;
+    size_t i;
+    double t0;
+    double encodeSec;
+    double decodeSec;
+    double hours;
+
+    if ((0u == count) || (NULL == records) || (NULL == decoded) || (NULL == pages))
+    {
+        fprintf(stderr, "usage: %s [records]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Bench_Generate(records, count);
+
+    t0 = Bench_Now();
+    pageCount = Bench_Encode(records, count, pages, &payloadBytes);
+    encodeSec = Bench_Now() - t0;
+
+    t0 = Bench_Now();
+    decodedCount = Bench_Decode(pages, pageCount, decoded);
+    decodeSec = Bench_Now() - t0;
+
+    /* Round trip check */
+    if (decodedCount != count)
+    {
+        fprintf(stderr, "decoded %zu records, expected %zu\n", decodedCount, count);
+        return EXIT_FAILURE;
+    }
+    for (i = 0u; i < count; i++)
+    {
+        if ((records[i].time != decoded[i].time) || (records[i].kind != decoded[i].kind) ||
+            (records[i].from != decoded[i].from) || (records[i].to != decoded[i].to) ||
+            (records[i].residency != decoded[i].residency))
+        {
+            fprintf(stderr, "record %zu does not match\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    rawPages = (count + TELEMETRY_RAW_RECORDS_PER_PAGE - 1u) / TELEMETRY_RAW_RECORDS_PER_PAGE;
+    hours = (double)records[count - 1u].time / (3600.0 * BENCH_TICKS_PER_SEC);
+
+    printf("records          : %zu (%.1f hours of activity)\n", count, hours);
+    printf("packed           : %.2f bytes/record, %zu pages\n", (double)payloadBytes / (double)count, pageCount);
+    printf("raw              : %u bytes/record, %zu pages\n", TELEMETRY_RAW_RECORD_SIZE, rawPages);
+    printf("page programs/h  : %.2f packed, %.2f raw (%.1fx fewer)\n",
+           (double)pageCount / hours, (double)rawPages / hours, (double)rawPages / (double)pageCount);
+    printf("encode           : %.1f Mrecords/s, %.1f MB/s of pages\n",
+           (double)count / encodeSec * 1e-6, (double)(pageCount * TELEMETRY_PAGE_SIZE) / encodeSec * 1e-6);
+    printf("decode           : %.1f Mrecords/s, %.1f MB/s of pages\n",
+           (double)count / decodeSec * 1e-6, (double)(pageCount * TELEMETRY_PAGE_SIZE) / decodeSec * 1e-6);
+
+    free(pages);
+    free(decoded);
+    free(records);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */